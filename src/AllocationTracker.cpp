@@ -0,0 +1,172 @@
+#include "AllocationTracker.h"
+
+#include <new>
+
+mutex AllocationTracker::tags_mutex_;
+string AllocationTracker::names_[ALLOCATION_MAX_TAGS];
+atomic<int> AllocationTracker::tag_count_(0);
+thread_local int AllocationTracker::current_tag_ = 0;
+AllocationTracker::ThreadCounters AllocationTracker::counters_[ALLOCATION_MAX_THREADS] = {};
+AllocationTracker::ThreadCounters AllocationTracker::shared_counters_ = {};
+atomic<int> AllocationTracker::counters_claimed_(0);
+thread_local AllocationTracker::ThreadCounters* AllocationTracker::thread_counters_ = nullptr;
+uint32_t AllocationTracker::seen_counts_[ALLOCATION_MAX_THREADS + 1][ALLOCATION_MAX_TAGS] = {};
+uint64_t AllocationTracker::seen_bytes_[ALLOCATION_MAX_THREADS + 1][ALLOCATION_MAX_TAGS] = {};
+uint32_t AllocationTracker::last_counts_[ALLOCATION_MAX_TAGS] = {};
+uint64_t AllocationTracker::last_bytes_[ALLOCATION_MAX_TAGS] = {};
+bool AllocationTracker::flagged_[ALLOCATION_MAX_TAGS] = {};
+uint32_t AllocationTracker::frame_count_ = 0;
+uint64_t AllocationTracker::frame_bytes_ = 0;
+uint64_t AllocationTracker::total_count_ = 0;
+uint64_t AllocationTracker::frames_ = 0;
+bool AllocationTracker::strict_ = false;
+atomic<int> AllocationTracker::warmup_(ALLOCATION_WARMUP_FRAMES);
+
+int AllocationTracker::register_tag(const string& name)
+{
+	lock_guard<mutex> lock(tags_mutex_);
+
+	// tag 0 collects anything allocated outside a tagged scope
+	if (tag_count_ == 0) names_[tag_count_++] = "untagged";
+
+	for (int i = 0; i < tag_count_; i++)
+	{
+		if (names_[i] == name) return i;
+	}
+
+	if (tag_count_ == ALLOCATION_MAX_TAGS)
+	{
+		cout << "Error: Too many allocation tags, '" << name << "' is counted as untagged" << endl;
+		return 0;
+	}
+
+	names_[tag_count_] = name;
+	return tag_count_++;
+}
+
+// a thread keeps its counters after it exits - threads are few and long lived, the rest share the last set
+AllocationTracker::ThreadCounters* AllocationTracker::claim_counters()
+{
+	const int index = counters_claimed_.fetch_add(1, memory_order_relaxed);
+	return (index < ALLOCATION_MAX_THREADS) ? &counters_[index] : &shared_counters_;
+}
+
+void AllocationTracker::end_frame()
+{
+	frame_count_ = 0;
+	frame_bytes_ = 0;
+
+	const int tag_count = max(tag_count_.load(), 1);
+	fill(last_counts_, last_counts_ + tag_count, 0);
+	fill(last_bytes_, last_bytes_ + tag_count, 0);
+
+	// the shared counters are seen as the last slot
+	const int claimed = min(counters_claimed_.load(memory_order_relaxed), ALLOCATION_MAX_THREADS);
+	for (int t = 0; t <= ALLOCATION_MAX_THREADS; t++)
+	{
+		if (t >= claimed && t < ALLOCATION_MAX_THREADS) continue;
+
+		const ThreadCounters& counters = (t < ALLOCATION_MAX_THREADS) ? counters_[t] : shared_counters_;
+		for (int i = 0; i < tag_count; i++)
+		{
+			const uint32_t count = counters.counts[i].load(memory_order_relaxed);
+			const uint64_t bytes = counters.bytes[i].load(memory_order_relaxed);
+			last_counts_[i] += count - seen_counts_[t][i];
+			last_bytes_[i] += bytes - seen_bytes_[t][i];
+			seen_counts_[t][i] = count;
+			seen_bytes_[t][i] = bytes;
+		}
+	}
+
+	for (int i = 0; i < tag_count; i++)
+	{
+		frame_count_ += last_counts_[i];
+		frame_bytes_ += last_bytes_[i];
+	}
+	total_count_ += frame_count_;
+	frames_++;
+
+	// a restart between the load and the exchange wins, the exchange just fails
+	int warmup = warmup_.load(memory_order_relaxed);
+	if (warmup > 0)
+	{
+		warmup_.compare_exchange_strong(warmup, warmup - 1, memory_order_relaxed);
+		return;
+	}
+	if (!strict_) return;
+
+	// reported once per tag, until that tag has a frame without allocating again
+	for (int i = 0; i < tag_count; i++)
+	{
+		if (last_counts_[i] > 0 && !flagged_[i])
+		{
+			cout << "------------AllocationTracker.cpp------------" << endl;
+			cout << " [ Steady State Allocation ]" << endl;
+			cout << " - Frame " << ofGetFrameNum() << ": " << names_[i] << " allocated " << last_counts_[i] << " times (" << last_bytes_[i] << " bytes)" << endl;
+			cout << "---------------------------------------------" << endl;
+		}
+		flagged_[i] = last_counts_[i] > 0;
+	}
+}
+
+void AllocationTracker::draw(const float x, const float y)
+{
+	ofPushStyle();
+
+	float row_y = y;
+	ofSetColor(255);
+	ofDrawBitmapString("allocations            count     bytes", x, row_y);
+	row_y += 16;
+
+	const int tag_count = tag_count_;
+	for (int i = 0; i < tag_count; i++)
+	{
+		if (last_counts_[i] == 0) continue;
+
+		// red once strict mode would flag it
+		if (strict_ && warmup_.load(memory_order_relaxed) == 0) ofSetColor(255, 80, 80);
+		else ofSetColor(255);
+
+		const string padding(max(0, 20 - static_cast<int>(names_[i].size())), ' ');
+		ofDrawBitmapString(names_[i] + padding + ofToString(last_counts_[i], 0, 8, ' ') + ofToString(last_bytes_[i], 0, 10, ' '), x, row_y);
+		row_y += 14;
+	}
+
+	ofPopStyle();
+}
+
+#if ALLOCATION_TRACKING
+
+// replacing the global operator new counts allocations from everything linked in (oF and the addons included)
+// over-aligned news (align_val_t) aren't replaced and so aren't counted
+void* operator new(const size_t size)
+{
+	AllocationTracker::record(size);
+	if (void* memory = malloc((size > 0) ? size : 1)) return memory;
+	throw bad_alloc();
+}
+
+void* operator new[](const size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(const size_t size, const nothrow_t&) noexcept
+{
+	AllocationTracker::record(size);
+	return malloc((size > 0) ? size : 1);
+}
+
+void* operator new[](const size_t size, const nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept								{ free(memory); }
+void operator delete[](void* memory) noexcept							{ free(memory); }
+void operator delete(void* memory, size_t) noexcept						{ free(memory); }
+void operator delete[](void* memory, size_t) noexcept					{ free(memory); }
+void operator delete(void* memory, const nothrow_t&) noexcept			{ free(memory); }
+void operator delete[](void* memory, const nothrow_t&) noexcept			{ free(memory); }
+
+#endif
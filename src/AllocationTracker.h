@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "ofMain.h"
+
+#ifndef ALLOCATION_TRACKING
+#define ALLOCATION_TRACKING			1		// 0 (-DALLOCATION_TRACKING=0) leaves the global operator new alone
+#endif
+#define ALLOCATION_MAX_TAGS			64
+#define ALLOCATION_MAX_THREADS		64		// threads past this share one set of counters
+#define ALLOCATION_WARMUP_FRAMES	120		// frames after startup or a scene load before strict mode starts flagging
+
+// counts every heap allocation (global operator new) against the subsystem that made it, reported per frame
+// the subsystem is a per thread tag - task graph tasks tag themselves by name, parallel_for chunks inherit the tag of the caller
+// every thread counts into its own cache line aligned counters, end_frame sums them, so allocating never contends with another thread
+// strict mode flags any allocation once the frame should be in a steady state
+class AllocationTracker {
+
+public:
+
+	// returns the existing tag if the name is already registered
+	static int register_tag(const string& name);
+
+	static int get_tag()						{ return current_tag_; }
+	static void set_tag(int tag)				{ current_tag_ = tag; }
+
+	// called by operator new, mustn't allocate
+	static void record(size_t bytes)
+	{
+		ThreadCounters* counters = thread_counters_;
+		if (counters == nullptr) counters = thread_counters_ = claim_counters();
+
+		const int tag = current_tag_;
+		if (counters == &shared_counters_)
+		{
+			counters->counts[tag].fetch_add(1, memory_order_relaxed);
+			counters->bytes[tag].fetch_add(bytes, memory_order_relaxed);
+			return;
+		}
+
+		// only this thread writes its counters - a plain load and store, end_frame just reads them
+		counters->counts[tag].store(counters->counts[tag].load(memory_order_relaxed) + 1, memory_order_relaxed);
+		counters->bytes[tag].store(counters->bytes[tag].load(memory_order_relaxed) + bytes, memory_order_relaxed);
+	}
+
+	// main thread, once per frame - what was counted since the last call becomes the frame's
+	static void end_frame();
+
+	static void set_strict(bool strict)			{ strict_ = strict; }
+	static void restart_warmup()				{ warmup_.store(ALLOCATION_WARMUP_FRAMES, memory_order_relaxed); } // any thread, scenes load on batch workers too
+
+	// last frame's
+	static uint32_t get_frame_count()			{ return frame_count_; }
+	static uint64_t get_frame_bytes()			{ return frame_bytes_; }
+
+	// since startup
+	static uint64_t get_total_count()			{ return total_count_; }
+	static uint64_t get_frames()				{ return frames_; }
+
+	// last frame's counts per tag
+	static void draw(float x, float y);
+
+private:
+
+	static mutex tags_mutex_;
+	static string names_[ALLOCATION_MAX_TAGS];
+	static atomic<int> tag_count_;
+	static thread_local int current_tag_;
+
+	// running totals, never reset - end_frame takes the difference to what it saw last time
+	struct alignas(64) ThreadCounters {
+		atomic<uint32_t> counts[ALLOCATION_MAX_TAGS];
+		atomic<uint64_t> bytes[ALLOCATION_MAX_TAGS];
+	};
+
+	static ThreadCounters* claim_counters();
+
+	static ThreadCounters counters_[ALLOCATION_MAX_THREADS];
+	static ThreadCounters shared_counters_;
+	static atomic<int> counters_claimed_;
+	static thread_local ThreadCounters* thread_counters_;
+
+	// main thread only
+	static uint32_t seen_counts_[ALLOCATION_MAX_THREADS + 1][ALLOCATION_MAX_TAGS];
+	static uint64_t seen_bytes_[ALLOCATION_MAX_THREADS + 1][ALLOCATION_MAX_TAGS];
+	static uint32_t last_counts_[ALLOCATION_MAX_TAGS];
+	static uint64_t last_bytes_[ALLOCATION_MAX_TAGS];
+	static bool flagged_[ALLOCATION_MAX_TAGS];
+	static uint32_t frame_count_;
+	static uint64_t frame_bytes_;
+	static uint64_t total_count_;
+	static uint64_t frames_;
+	static bool strict_;
+	static atomic<int> warmup_;
+
+};
+
+// tags the rest of the enclosing block's allocations
+class AllocationScope {
+
+public:
+
+	explicit AllocationScope(const int tag)
+		:	previous_(AllocationTracker::get_tag())
+	{
+		AllocationTracker::set_tag(tag);
+	}
+
+	~AllocationScope()
+	{
+		AllocationTracker::set_tag(previous_);
+	}
+
+	AllocationScope(const AllocationScope&) = delete;
+	AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+
+	int previous_;
+
+};
@@ -0,0 +1,99 @@
+#include "AssetManager.h"
+
+void AssetManager::begin(JobSystem* jobs)
+{
+	jobs_ = jobs;
+	begin_time_ = ofGetElapsedTimeMicros();
+
+	lock_guard<mutex> lock(entries_mutex_);
+	entries_.clear();
+	lanes_.assign(1, this_thread::get_id());
+}
+
+void AssetManager::load_async(const string& name, function<void()> load)
+{
+	pending_++;
+	jobs_->submit([this, name, load = move(load)]
+	{
+		const uint64_t start = ofGetElapsedTimeMicros();
+		{
+			PROFILE_SCOPE("asset load");
+			load();
+		}
+		record(name, start, ofGetElapsedTimeMicros());
+		pending_--;
+	});
+}
+
+void AssetManager::load(const string& name, const function<void()>& load)
+{
+	const uint64_t start = ofGetElapsedTimeMicros();
+	load();
+	record(name, start, ofGetElapsedTimeMicros());
+}
+
+void AssetManager::wait()
+{
+	while (pending_ > 0)
+	{
+		if (!jobs_->run_one()) this_thread::yield();
+	}
+	ready_time_ = ofGetElapsedTimeMicros();
+}
+
+const ofTrueTypeFont* AssetManager::get_font(const string& path, const int size)
+{
+	unique_ptr<ofTrueTypeFont>& font = fonts_[{ path, size }];
+	if (!font)
+	{
+		font = make_unique<ofTrueTypeFont>();
+		load(ofFilePath::getFileName(path) + " " + ofToString(size), [&font, &path, size] { font->load(path, size, true, true); });
+	}
+	return font.get();
+}
+
+void AssetManager::record(const string& name, const uint64_t start, const uint64_t end)
+{
+	lock_guard<mutex> lock(entries_mutex_);
+
+	const thread::id id = this_thread::get_id();
+	int lane = static_cast<int>(find(lanes_.begin(), lanes_.end(), id) - lanes_.begin());
+	if (lane == static_cast<int>(lanes_.size())) lanes_.push_back(id);
+
+	entries_.push_back({ name, lane, start - begin_time_, end - begin_time_ });
+}
+
+void AssetManager::report() const
+{
+	lock_guard<mutex> lock(entries_mutex_);
+
+	vector<Entry> entries = entries_;
+	sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.start < b.start; });
+
+	uint64_t serial = 0;
+	for (auto& entry : entries)
+	{
+		serial += entry.end - entry.start;
+	}
+
+	cout << "------------AssetManager.cpp------------" << endl;
+	cout << " [ Startup Timeline ]" << endl;
+	for (auto& entry : entries)
+	{
+		const string lane = (entry.lane == 0) ? "main" : "worker " + ofToString(entry.lane);
+		const string padding(max(0, 32 - static_cast<int>(entry.name.size())), ' ');
+		cout << " - " << entry.name << padding << ofToString(entry.start / 1000.0f, 1, 7, ' ') << "ms +" << ofToString((entry.end - entry.start) / 1000.0f, 1) << "ms  " << lane << endl;
+	}
+	cout << " - Loaded in " << ofToString((ready_time_ - begin_time_) / 1000.0f, 1) << "ms (" << ofToString(serial / 1000.0f, 1) << "ms one after another), " << fonts_.size() << " font faces" << endl;
+	cout << "----------------------------------------" << endl;
+}
+
+void AssetManager::first_frame_drawn()
+{
+	if (first_frame_drawn_) return;
+	first_frame_drawn_ = true;
+
+	cout << "------------AssetManager.cpp------------" << endl;
+	cout << " - First frame drawn " << ofToString((ofGetElapsedTimeMicros() - begin_time_) / 1000.0f, 1) << "ms after setup began (" << ofToString(ofGetElapsedTimeMillis()) << "ms after launch)" << endl;
+	cout << "----------------------------------------" << endl;
+}
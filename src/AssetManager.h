@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "ofMain.h"
+#include "JobSystem.h"
+
+// startup loading - file decoding and parsing goes to the job pool while the main thread does what needs the GL context (fonts, FBOs)
+// fonts are shared, every face/size pair is loaded once however many managers ask for it
+// every load and setup step is timed, report() prints them as a startup timeline
+class AssetManager {
+
+public:
+
+	// loads go to jobs, or run inline if its workers aren't running
+	void begin(JobSystem* jobs);
+
+	// on the pool - anything touched by load must be left alone until wait()
+	void load_async(const string& name, function<void()> load);
+
+	// here, timed - for setup that needs the GL context
+	void load(const string& name, const function<void()>& load);
+
+	// helps with the outstanding loads until they've all finished
+	void wait();
+
+	// main thread - loaded on first use, needs the GL context
+	const ofTrueTypeFont* get_font(const string& path, int size);
+
+	void report() const;
+
+	// once, at the end of the first drawn frame
+	void first_frame_drawn();
+
+private:
+
+	struct Entry {
+		string name;
+		int lane;			// 0 is the main thread, workers get the next free lane the first time they load something
+		uint64_t start;		// microseconds since begin()
+		uint64_t end;
+	};
+
+	void record(const string& name, uint64_t start, uint64_t end);
+
+	JobSystem* jobs_ = nullptr;
+	uint64_t begin_time_ = 0;
+	uint64_t ready_time_ = 0;	// wait() returned
+	bool first_frame_drawn_ = false;
+
+	atomic<int> pending_{ 0 };
+
+	mutable mutex entries_mutex_;
+	vector<Entry> entries_;
+	vector<thread::id> lanes_;
+
+	map<pair<string, int>, unique_ptr<ofTrueTypeFont>> fonts_;
+
+};
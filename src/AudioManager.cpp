@@ -8,20 +8,21 @@ AudioManager::~AudioManager()
 }
 
 //--------------------------------------------------------------
-void AudioManager::soundSetup(ofBaseApp* appPtr) {
+void AudioManager::soundSetup(ofBaseApp* appPtr, bool openStream) {
 
     //=======MAXIM-SOUND-SETUP=========//
     sampleRate = 44100;
     bufferSize = 512;
     ofxMaxiSettings::setup(sampleRate, 2, bufferSize);
     //=====================================================//
+    if (!openStream) return; // headless - audioOut is pumped by the app instead of the DAC
     ofSoundStreamSetup(2, 0, appPtr, sampleRate, bufferSize, 4);
     /* this has to happen at the end of setup - it switches on the DAC */
 }
 
 
 //===============================================================//
-void AudioManager::setup(ofBaseApp* appPtr) {
+void AudioManager::setup(AssetManager& assets) {
 
     //=======OF-SETUP======//
     ofSetFrameRate(60);
@@ -38,11 +39,11 @@ void AudioManager::setup(ofBaseApp* appPtr) {
     }
 
     //============================================//
-    loadSamples();         //load samples
+    loadSamples(assets);         //load samples
     envelopeSetup();
     clockSetup();   //setup tempo and ticks per beat
     guiSetup();    //setup gui
-    soundSetup(appPtr);  //run at the end of setup!
+    //soundSetup is run by the app once the samples have loaded
     //============================================//
 }
 
@@ -103,31 +104,38 @@ void AudioManager::guiSetup() {
 }
 
 //--------------------------------------------------------------
-void AudioManager::loadSamples() {
+void AudioManager::loadSamples(AssetManager& assets) {
 
     //==================LOAD-SAMPLES-HERE===================//
-    metronome.load(ofToDataPath("./audio/samples/rim.wav"));
-    snare.load(ofToDataPath("./audio/samples/snare2.wav"));
+    loadSample(assets, metronome, "./audio/samples/rim.wav");
+    loadSample(assets, snare, "./audio/samples/snare2.wav");
 
 
-    hit1.load(ofToDataPath("./audio/samples/synthSpace_hi.wav"));
-    hit2.load(ofToDataPath("./audio/samples/synthSpace_mid.wav"));
-    hit3.load(ofToDataPath("./audio/samples/synthSpace_low.wav"));
-    hit4.load(ofToDataPath("./audio/samples/synthSpace4.wav"));
-    hit5.load(ofToDataPath("./audio/samples/synthSpace5.wav"));
-    hit6.load(ofToDataPath("./audio/samples/synthSpace6.wav"));
-    hit7.load(ofToDataPath("./audio/samples/synthSpace7.wav"));
-    hit8.load(ofToDataPath("./audio/samples/synthSpace8.wav"));
+    loadSample(assets, hit1, "./audio/samples/synthSpace_hi.wav");
+    loadSample(assets, hit2, "./audio/samples/synthSpace_mid.wav");
+    loadSample(assets, hit3, "./audio/samples/synthSpace_low.wav");
+    loadSample(assets, hit4, "./audio/samples/synthSpace4.wav");
+    loadSample(assets, hit5, "./audio/samples/synthSpace5.wav");
+    loadSample(assets, hit6, "./audio/samples/synthSpace6.wav");
+    loadSample(assets, hit7, "./audio/samples/synthSpace7.wav");
+    loadSample(assets, hit8, "./audio/samples/synthSpace8.wav");
 
 
-    hitSub.load(ofToDataPath("./audio/samples/subAtmosphere.wav"));
+    loadSample(assets, hitSub, "./audio/samples/subAtmosphere.wav");
 
     //=====================LOAD-LOOPS=======================//
-    atmos.load(ofToDataPath("./audio/loops/atmosphere.wav"));
+    loadSample(assets, atmos, "./audio/loops/atmosphere.wav");
 
 
 }
 
+//--------------------------------------------------------------
+void AudioManager::loadSample(AssetManager& assets, maxiSample& sample, const string& path) {
+    //decoding a wav only touches the sample itself, so they can all load at once
+    const string data_path = ofToDataPath(path);
+    assets.load_async(ofFilePath::getFileName(path), [&sample, data_path] { sample.load(data_path); });
+}
+
 //--------------------------------------------------------------
 void AudioManager::clockSetup() {
     //setup tempo and ticks per beat//
@@ -969,24 +977,24 @@ void AudioManager::update(const ofVec2f player_position) {
     //MAP-PLAYER-POSITION-TO-SOUND-EFFECTS-AND-ENVELOPES
     //-------------------------------------//
     //set low pass filter to player y pos, top of map all frequencies pass bottom of map apply filter effect
-    double partWorldHeight = HALF_WORLD_HEIGHT / 3;
+    double partWorldHeight = world::HALF_WORLD_HEIGHT / 3;
     if (player_pos.y > partWorldHeight) {
-        playerFilter = ofMap(player_pos.y, partWorldHeight, HALF_WORLD_HEIGHT, 4000, 20);
+        playerFilter = ofMap(player_pos.y, partWorldHeight, world::HALF_WORLD_HEIGHT, 4000, 20);
     }
     else {
         playerFilter = 4000;
     }
     //-------------------------------------//
 
-    playerDelayFeedback = ofMap(player_pos.y, HALF_WORLD_HEIGHT, -HALF_WORLD_HEIGHT, 0.1, 0.8);
-    playerDelayMix = ofMap(player_pos.y, HALF_WORLD_HEIGHT, -HALF_WORLD_HEIGHT, 0.9, 0.1);
+    playerDelayFeedback = ofMap(player_pos.y, world::HALF_WORLD_HEIGHT, -world::HALF_WORLD_HEIGHT, 0.1, 0.8);
+    playerDelayMix = ofMap(player_pos.y, world::HALF_WORLD_HEIGHT, -world::HALF_WORLD_HEIGHT, 0.9, 0.1);
 
     //set hi res filter to activate at the top and bottom of WORLD
     if (player_pos.y > partWorldHeight) {
-        playerFilterHires = ofMap(player_pos.y, partWorldHeight, HALF_WORLD_HEIGHT, 0, 100.0);
+        playerFilterHires = ofMap(player_pos.y, partWorldHeight, world::HALF_WORLD_HEIGHT, 0, 100.0);
     }
     else if (player_pos.y < -partWorldHeight * 2) {
-        playerFilterHires = ofMap(player_pos.y, -partWorldHeight * 2, -HALF_WORLD_HEIGHT, 0, 400.0);
+        playerFilterHires = ofMap(player_pos.y, -partWorldHeight * 2, -world::HALF_WORLD_HEIGHT, 0, 400.0);
     }
     else {
         playerFilterHires = 0;
@@ -994,14 +1002,14 @@ void AudioManager::update(const ofVec2f player_position) {
 
     //-------------------------------------//
     //synth line attack and release are afected when player is in the left and right segments of WORLD WIDTH
-    double partWorldWidth = HALF_WORLD_WIDTH / 3;
+    double partWorldWidth = world::HALF_WORLD_WIDTH / 3;
     if (player_pos.x > partWorldWidth) {
-        playerSynthLineAttack = ofMap(player_pos.x, partWorldWidth, HALF_WORLD_WIDTH, 3, 500);
-        playerSynthLineRelease = ofMap(player_pos.x, partWorldWidth, HALF_WORLD_WIDTH, 600, 700);
+        playerSynthLineAttack = ofMap(player_pos.x, partWorldWidth, world::HALF_WORLD_WIDTH, 3, 500);
+        playerSynthLineRelease = ofMap(player_pos.x, partWorldWidth, world::HALF_WORLD_WIDTH, 600, 700);
     }
     else if (player_pos.x < -partWorldWidth) {
-        playerSynthLineAttack = ofMap(player_pos.x, -partWorldWidth, -HALF_WORLD_WIDTH, 3, 500);
-        playerSynthLineRelease = ofMap(player_pos.x, -partWorldWidth, -HALF_WORLD_WIDTH, 600, 200);
+        playerSynthLineAttack = ofMap(player_pos.x, -partWorldWidth, -world::HALF_WORLD_WIDTH, 3, 500);
+        playerSynthLineRelease = ofMap(player_pos.x, -partWorldWidth, -world::HALF_WORLD_WIDTH, 600, 200);
     }
     else {
         playerSynthLineAttack = 3;
@@ -4,6 +4,7 @@
 #include "ofxMaxim.h"
 #include "ofxGui.h"
 
+#include "AssetManager.h"
 #include "Controller.h" // <--- for global world dimensions
 
 class AudioManager {
@@ -11,7 +12,7 @@ class AudioManager {
 public:
     ~AudioManager();
 
-    void setup(ofBaseApp* appPtr);
+    void setup(AssetManager& assets);      //samples are still loading when this returns - soundSetup once they are
     void update(ofVec2f player_position);
     void draw();
     void drawGUI(bool enable);
@@ -19,10 +20,11 @@ public:
 
     //--------------SETUPS-----------------//
     void envelopeSetup();                  //set up envelopes
-    void loadSamples();                    //load audio samples
+    void loadSamples(AssetManager& assets); //load audio samples, each one on the job pool
+    void loadSample(AssetManager& assets, maxiSample& sample, const string& path);
     void guiSetup();                       //setup gui
     void clockSetup();                     //setup clock
-    void soundSetup(ofBaseApp* appPtr);    //setup audio
+    void soundSetup(ofBaseApp* appPtr, bool openStream);    //setup audio
 
 
     //==============SOUNDS================//
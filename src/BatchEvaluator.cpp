@@ -0,0 +1,251 @@
+#include "BatchEvaluator.h"
+
+BatchEvaluator::BatchEvaluator(const int scene_count, const int frames, const int first_seed, const int thread_count)
+	:	scene_count_(max(scene_count, 1))
+	,	frames_(max(frames, 1))
+	,	first_seed_(first_seed)
+	,	thread_count_((thread_count > 0) ? thread_count : max(1, static_cast<int>(thread::hardware_concurrency())))
+	,	next_scene_(0)
+	,	scenes_done_(0)
+{
+}
+
+void BatchEvaluator::run()
+{
+	cout << "------------BatchEvaluator.cpp------------" << endl;
+	cout << " [ Batch Evaluation ]" << endl;
+	cout << " - Scenes: " << scene_count_ << ", seeds " << first_seed_ << " to " << first_seed_ + scene_count_ - 1 << endl;
+	cout << " - Frames per scene: " << frames_ << endl;
+	cout << " - Threads: " << thread_count_ << endl;
+	cout << "------------------------------------------" << endl;
+
+	results_.assign(scene_count_, SceneResult());
+	const uint64_t start = ofGetElapsedTimeMicros();
+
+	vector<thread> threads;
+	for (int i = 0; i < min(thread_count_, scene_count_); i++)
+	{
+		threads.emplace_back([this] { worker_loop(); });
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	seconds_ = max((ofGetElapsedTimeMicros() - start) / 1000000.0f, 0.000001f);
+
+	if (threads.size() > 1) mismatches_ = verify_single_threaded();
+
+	int solved = 0;
+	double step_total = 0;
+	for (auto& result : results_)
+	{
+		if (result.solved_frame >= 0) solved++;
+		step_total += result.mean_ms;
+	}
+
+	cout << "------------BatchEvaluator.cpp------------" << endl;
+	cout << " [ Batch Evaluation Finished ]" << endl;
+	cout << " - Solved by the sweep: " << solved << " of " << scene_count_ << endl;
+	cout << " - Mean step: " << ofToString(step_total / scene_count_, 3) << "ms" << endl;
+	if (verified_ > 0) cout << " - Same result on one thread: " << verified_ - mismatches_ << " of " << verified_ << " scenes" << endl;
+	cout << " - Time: " << ofToString(seconds_, 2) << "s, " << ofToString(scene_count_ / seconds_, 1) << " scenes/s, " << ofToString(scene_count_ * static_cast<double>(frames_) / seconds_, 0) << " steps/s" << endl;
+	cout << "------------------------------------------" << endl;
+}
+
+unique_ptr<BatchEvaluator::World> BatchEvaluator::create_world()
+{
+	lock_guard<mutex> lock(setup_mutex_);
+	auto world = make_unique<World>();
+	world->setup();
+	return world;
+}
+
+void BatchEvaluator::destroy_world(unique_ptr<World> world)
+{
+	lock_guard<mutex> lock(setup_mutex_);
+	world.reset();
+}
+
+void BatchEvaluator::worker_loop()
+{
+	Profiler::set_thread_name("batch eval");
+
+	for (int index = next_scene_++; index < scene_count_; index = next_scene_++)
+	{
+		unique_ptr<World> world = create_world();
+		results_[index] = evaluate(*world, first_seed_ + index);
+		destroy_world(move(world));
+
+		const int done = ++scenes_done_;
+		if (done % BATCH_EVAL_PROGRESS_INTERVAL == 0 || done == scene_count_)
+		{
+			lock_guard<mutex> lock(print_mutex_);
+			cout << " - " << done << " of " << scene_count_ << " scenes evaluated" << endl;
+		}
+	}
+}
+
+BatchEvaluator::SceneResult BatchEvaluator::evaluate(World& world, const int seed) const
+{
+	// everything this scene draws or counts goes to the world's own context
+	WorldScope world_scope(&world.context);
+	world.context.seed(seed);
+	world.scene_manager.load_procedural_scene();
+
+	SceneResult result;
+	result.seed = seed;
+
+	vector<float> step_times;
+	step_times.reserve(frames_);
+	for (int frame = 0; frame < frames_; frame++)
+	{
+		const uint64_t step_start = ofGetElapsedTimeMicros();
+		world.step(frame);
+		step_times.push_back((ofGetElapsedTimeMicros() - step_start) / 1000.0f);
+
+		// the scene as the first step left it
+		if (frame == 0) result.entity_count = static_cast<int>(world.entity_manager.get_game_objects()->size());
+
+		result.point_count = world.entity_manager.get_point_count();
+		result.points_collected = Collectable::get_points_collected();
+		if (result.point_count > 0 && result.points_collected >= result.point_count)
+		{
+			result.solved_frame = frame;
+			break;
+		}
+	}
+
+	double total = 0;
+	for (const float step_time : step_times)
+	{
+		total += step_time;
+	}
+	result.mean_ms = static_cast<float>(total / step_times.size());
+
+	sort(step_times.begin(), step_times.end());
+	result.p99_ms = step_times[min(static_cast<int>(ceil(0.99f * step_times.size())), static_cast<int>(step_times.size())) - 1];
+	result.max_ms = step_times.back();
+	return result;
+}
+
+bool BatchEvaluator::same_outcome(const SceneResult& a, const SceneResult& b)
+{
+	// the timings are allowed to differ, nothing else is
+	return a.seed == b.seed && a.entity_count == b.entity_count && a.point_count == b.point_count && a.points_collected == b.points_collected && a.solved_frame == b.solved_frame;
+}
+
+int BatchEvaluator::verify_single_threaded()
+{
+	verified_ = min(BATCH_EVAL_VERIFY_SCENES, scene_count_);
+
+	int mismatches = 0;
+	for (int index = 0; index < verified_; index++)
+	{
+		unique_ptr<World> world = create_world();
+		const SceneResult result = evaluate(*world, first_seed_ + index);
+		destroy_world(move(world));
+
+		if (!same_outcome(result, results_[index]))
+		{
+			mismatches++;
+			cout << "Error: Seed " << result.seed << " came out differently on one thread (" << result.points_collected << " points, solved at " << result.solved_frame << ") than in the batch (" << results_[index].points_collected << " points, solved at " << results_[index].solved_frame << ")" << endl;
+		}
+	}
+	return mismatches;
+}
+
+bool BatchEvaluator::save(const string& path) const
+{
+	ofJson json;
+	json["date"] = ofGetTimestampString("%Y-%m-%d %H:%M:%S");
+	json["frames_per_scene"] = frames_;
+	json["first_seed"] = first_seed_;
+	json["threads"] = thread_count_;
+	json["seconds"] = seconds_;
+	json["verified_scenes"] = verified_;
+	json["verify_mismatches"] = mismatches_;
+
+	ofJson scenes = ofJson::array();
+	for (auto& result : results_)
+	{
+		ofJson scene;
+		scene["seed"] = result.seed;
+		scene["entities"] = result.entity_count;
+		scene["points"] = result.point_count;
+		scene["points_collected"] = result.points_collected;
+		scene["solved_frame"] = result.solved_frame;
+		scene["step_mean_ms"] = result.mean_ms;
+		scene["step_p99_ms"] = result.p99_ms;
+		scene["step_max_ms"] = result.max_ms;
+		scenes.push_back(scene);
+	}
+	json["scenes"] = scenes;
+
+	const bool saved = ofSavePrettyJson(path, json);
+	cout << ((saved) ? " - Batch evaluation saved to " : "Error: Couldn't save batch evaluation to ") << path << endl;
+	return saved;
+}
+
+void BatchEvaluator::World::setup()
+{
+	WorldScope world_scope(&context);
+
+	// the same wiring as a headless Iota, minus the task graphs - step() runs the managers in the graph's order
+	event_manager.init(&entity_manager, &gui_manager, &gamemode_manager);
+	gamemode_manager.init(&gui_manager);
+	scene_manager.init(&game_controller, &gui_manager, &cam, &fluid_manager, &audio_manager, &entity_manager, &gamemode_manager);
+	entity_manager.init(&game_controller, &gui_manager, &cam, &fluid_manager, &audio_manager, &gamemode_manager, &input, &job_system);
+	fluid_manager.init(&gui_manager, &cam, true);
+	// job_system isn't started, the samples load inline
+	assets.begin(&job_system);
+	audio_manager.setup(assets);
+	assets.wait();
+	audio_manager.soundSetup(nullptr, false);
+	gui_manager.init(&game_controller, &audio_manager, &cam);
+	gamemode_manager.set_current_mode_id(1);
+	scene_manager.set_quiet(true);
+
+	input.window_width = ofGetWidth();
+	input.window_height = ofGetHeight();
+}
+
+void BatchEvaluator::World::step(const int frame)
+{
+	// nothing calls next_frame while the batch runs, so each world starts its thread's frame scratch over itself
+	FrameArena::rewind();
+
+	input.frame = frame;
+	script_input(frame);
+
+	cam.update(entity_manager.get_player_position(), input);
+	entity_manager.update();
+	fluid_manager.update();
+}
+
+void BatchEvaluator::World::script_input(const int frame)
+{
+	const int cycle = frame % 240;
+	const float angle = frame * TWO_PI / 240;
+	input.mouse_x = static_cast<int>(input.window_width / 2 + cos(angle) * 300);
+	input.mouse_y = static_cast<int>(input.window_height / 2 + sin(angle) * 300);
+
+	// straight to the world's handlers, the way Iota passes window events on (audio and the menus don't change the outcome)
+	const int x = input.mouse_x;
+	const int y = input.mouse_y;
+	if (cycle == 0 && event_manager.is_event_allowed("mouse_pressed", 0))
+	{
+		entity_manager.mouse_pressed(x, y, 0);
+		cam.mouse_pressed(x, y, 0);
+	}
+	else if (cycle > 0 && cycle < 180 && event_manager.is_event_allowed("mouse_dragged", 0))
+	{
+		entity_manager.mouse_dragged(x, y, 0);
+		cam.mouse_dragged(x, y, 0);
+	}
+	else if (cycle == 180 && event_manager.is_event_allowed("mouse_released", 0))
+	{
+		entity_manager.mouse_released(x, y, 0);
+		cam.mouse_released(x, y, 0);
+	}
+}
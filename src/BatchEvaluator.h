@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "ofMain.h"
+#include "AssetManager.h"
+#include "AudioManager.h"
+#include "Camera.h"
+#include "Controller.h"
+#include "EntityManager.h"
+#include "EventManager.h"
+#include "FluidManager.h"
+#include "GamemodeManager.h"
+#include "GUIManager.h"
+#include "JobSystem.h"
+#include "SceneManager.h"
+#include "core/FrameArena.h"
+#include "core/StepInput.h"
+#include "core/WorldContext.h"
+
+#define BATCH_EVAL_PROGRESS_INTERVAL 100 // scenes between progress lines
+#define BATCH_EVAL_VERIFY_SCENES 4 // re-evaluated on one thread after a multi-threaded batch, they have to come out the same
+
+// procedural scenes evaluated side by side (--batch-eval) - threads take scenes off a shared counter and build a fresh headless world for each
+// nothing carries over from one scene to the next (camera, fluid, particles, audio), so a seed's result doesn't depend on the thread count or the order scenes ran in
+// scene i is load_procedural_scene from seed first_seed + i, stepped frames times with a scripted player sweep
+// reports whether the sweep collected every point (and when) and the step timings, so thousands of scenes can be checked for solvability and cost
+class BatchEvaluator {
+
+public:
+
+	// thread_count < 1 uses one thread per hardware thread
+	BatchEvaluator(int scene_count, int frames, int first_seed, int thread_count);
+
+	void run();
+
+	bool save(const string& path) const;
+
+private:
+
+	// the managers Iota wires up for a headless run, with a world context of their own
+	// a world's entity step runs inline on its thread - its job system is never started
+	struct World {
+		WorldContext context;
+		StepInput input;
+
+		Controller game_controller;
+		GUIManager gui_manager;
+		Camera cam;
+		FluidManager fluid_manager;
+		AudioManager audio_manager;
+		EntityManager entity_manager;
+		GamemodeManager gamemode_manager{ 1 }; // procedural
+		EventManager event_manager;
+		SceneManager scene_manager;
+		JobSystem job_system;
+		AssetManager assets;
+
+		void setup();
+		void step(int frame);
+
+		// the benchmark's sweep - the mouse circles the middle of the window, held down for three seconds, then released for one
+		void script_input(int frame);
+	};
+
+	struct SceneResult {
+		int seed = 0;
+		int entity_count = 0;
+		int point_count = 0;
+		int points_collected = 0;
+		int solved_frame = -1;	// first frame with every point collected, -1 if the sweep never got there
+		float mean_ms = 0;		// per step
+		float p99_ms = 0;
+		float max_ms = 0;
+	};
+
+	// worlds are built and torn down under setup_mutex_, oF and the gui addon aren't safe to set up from several threads at once
+	unique_ptr<World> create_world();
+	void destroy_world(unique_ptr<World> world);
+
+	void worker_loop();
+	SceneResult evaluate(World& world, int seed) const;
+	static bool same_outcome(const SceneResult& a, const SceneResult& b);
+
+	// the first scenes again on this thread, counts the ones that came out differently
+	int verify_single_threaded();
+
+	int scene_count_;
+	int frames_;
+	int first_seed_;
+	int thread_count_;
+
+	atomic<int> next_scene_;
+	atomic<int> scenes_done_;
+	mutex print_mutex_;
+	mutex setup_mutex_;
+
+	vector<SceneResult> results_; // by scene index, each written by the one thread that evaluated it
+	float seconds_ = 0;
+	int verified_ = 0;
+	int mismatches_ = 0;
+
+};
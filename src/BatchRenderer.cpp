@@ -0,0 +1,303 @@
+#include "BatchRenderer.h"
+
+namespace
+{
+	// attribute slots 0-3 are used by oF for position/color/normal/texcoord
+	const int instance_attribute = 4;
+	const int color_attribute = 5;
+	const int width_attribute = 6;
+
+	// two triangles per instance, gl_Vertex carries the corner
+	const float circle_corners[12] = { -1, -1,  1, -1,  1, 1,  -1, -1,  1, 1,  -1, 1 };
+	const float line_corners[12] = { 0, -1,  1, -1,  1, 1,  0, -1,  1, 1,  0, 1 };
+
+	const string circle_vertex_shader = R"(
+		#version 120
+		attribute vec4 instance_circle; // x, y, diameter, ring width in pixels (0 = filled)
+		attribute vec4 instance_color;
+		uniform float pixel_size; // world units per screen pixel
+		varying vec2 local_pos;
+		varying vec2 shape; // radius, half ring width (world units)
+		varying vec4 color;
+		void main()
+		{
+			float radius = instance_circle.z * 0.5;
+			float half_ring = instance_circle.w * 0.5 * pixel_size;
+			float extent = radius + half_ring + pixel_size;
+			local_pos = gl_Vertex.xy * extent;
+			shape = vec2(radius, half_ring);
+			color = instance_color;
+			gl_Position = gl_ModelViewProjectionMatrix * vec4(instance_circle.xy + local_pos, 0.0, 1.0);
+		}
+	)";
+
+	const string circle_fragment_shader = R"(
+		#version 120
+		uniform float pixel_size;
+		varying vec2 local_pos;
+		varying vec2 shape;
+		varying vec4 color;
+		void main()
+		{
+			float d = length(local_pos);
+			float coverage = (shape.y > 0.0) ? (shape.y - abs(d - shape.x)) : (shape.x - d);
+			coverage = clamp(coverage / pixel_size + 0.5, 0.0, 1.0);
+			if (coverage <= 0.0) discard;
+			gl_FragColor = vec4(color.rgb, color.a * coverage);
+		}
+	)";
+
+	const string line_vertex_shader = R"(
+		#version 120
+		attribute vec4 instance_line; // from x/y, to x/y
+		attribute vec4 instance_color;
+		attribute float instance_width; // pixels
+		uniform float pixel_size;
+		varying float offset;
+		varying float half_width;
+		varying vec4 color;
+		void main()
+		{
+			vec2 dir = instance_line.zw - instance_line.xy;
+			float len = length(dir);
+			vec2 normal = (len > 0.0) ? vec2(-dir.y, dir.x) / len : vec2(0.0);
+			half_width = instance_width * 0.5 * pixel_size;
+			offset = gl_Vertex.y * (half_width + pixel_size);
+			color = instance_color;
+			vec2 pos = mix(instance_line.xy, instance_line.zw, gl_Vertex.x) + normal * offset;
+			gl_Position = gl_ModelViewProjectionMatrix * vec4(pos, 0.0, 1.0);
+		}
+	)";
+
+	const string line_fragment_shader = R"(
+		#version 120
+		uniform float pixel_size;
+		varying float offset;
+		varying float half_width;
+		varying vec4 color;
+		void main()
+		{
+			float coverage = clamp((half_width - abs(offset)) / pixel_size + 0.5, 0.0, 1.0);
+			if (coverage <= 0.0) discard;
+			gl_FragColor = vec4(color.rgb, color.a * coverage);
+		}
+	)";
+}
+
+void BatchList::clear()
+{
+	circle_instances.clear();
+	circle_colors.clear();
+	line_instances.clear();
+	line_colors.clear();
+	line_widths.clear();
+	dotted_lines.clear();
+}
+
+BatchRenderer::BatchRenderer()
+	:	is_setup_(false)
+	,	instancing_supported_(false)
+	,	list_(nullptr)
+	,	draw_calls_(0)
+{
+}
+
+void BatchRenderer::setup()
+{
+	circle_shader_.setupShaderFromSource(GL_VERTEX_SHADER, circle_vertex_shader);
+	circle_shader_.setupShaderFromSource(GL_FRAGMENT_SHADER, circle_fragment_shader);
+	circle_shader_.bindAttribute(instance_attribute, "instance_circle");
+	circle_shader_.bindAttribute(color_attribute, "instance_color");
+	circle_shader_.linkProgram();
+
+	line_shader_.setupShaderFromSource(GL_VERTEX_SHADER, line_vertex_shader);
+	line_shader_.setupShaderFromSource(GL_FRAGMENT_SHADER, line_fragment_shader);
+	line_shader_.bindAttribute(instance_attribute, "instance_line");
+	line_shader_.bindAttribute(color_attribute, "instance_color");
+	line_shader_.bindAttribute(width_attribute, "instance_width");
+	line_shader_.linkProgram();
+
+	// the window is a GL 2.1 context, so instancing is only available through the ARB extensions
+	instancing_supported_ = ofGLCheckExtension("GL_ARB_instanced_arrays") && ofGLCheckExtension("GL_ARB_draw_instanced");
+	if (instancing_supported_)
+	{
+		// every instance shares the same six corners, uploaded once here - draw() only binds them
+		circle_vbo_.setVertexData(circle_corners, 2, 6, GL_STATIC_DRAW);
+		line_vbo_.setVertexData(line_corners, 2, 6, GL_STATIC_DRAW);
+	}
+
+	is_setup_ = true;
+
+	cout << "------------BatchRenderer.cpp------------" << endl;
+	cout << " - Instanced drawing: " << (instancing_supported_ ? "enabled" : "not supported, using expanded vertices") << endl;
+	cout << "----------------------------------------" << endl;
+}
+
+void BatchRenderer::begin(BatchList& list, const float world_units_per_pixel)
+{
+	list_ = &list;
+	list_->clear();
+	list_->pixel_size = world_units_per_pixel;
+}
+
+void BatchRenderer::end()
+{
+	list_ = nullptr;
+}
+
+void BatchRenderer::draw(const BatchList& list)
+{
+	draw_calls_ = 0;
+	if (!is_setup_) return;
+
+	// lines first - spring nodes are filled on top of their connecting lines
+	draw_dotted_lines(list);
+	draw_lines(list);
+	draw_circles(list);
+}
+
+void BatchRenderer::add_fill(const Vec2 pos, const float size, const ofColor& color)
+{
+	if (list_ == nullptr) return;
+
+	list_->circle_instances.push_back(pos.x);
+	list_->circle_instances.push_back(pos.y);
+	list_->circle_instances.push_back(size);
+	list_->circle_instances.push_back(0);
+	push_color(list_->circle_colors, color);
+}
+
+void BatchRenderer::add_outline(const Vec2 pos, const float size, const float line_width, const ofColor& color)
+{
+	if (list_ == nullptr) return;
+
+	// gl lines thinner than a pixel were still rasterised one pixel wide
+	list_->circle_instances.push_back(pos.x);
+	list_->circle_instances.push_back(pos.y);
+	list_->circle_instances.push_back(size);
+	list_->circle_instances.push_back(max(line_width, 1.0f));
+	push_color(list_->circle_colors, color);
+}
+
+void BatchRenderer::add_line(const Vec2 from, const Vec2 to, const float line_width, const ofColor& color)
+{
+	if (list_ == nullptr) return;
+
+	list_->line_instances.push_back(from.x);
+	list_->line_instances.push_back(from.y);
+	list_->line_instances.push_back(to.x);
+	list_->line_instances.push_back(to.y);
+	push_color(list_->line_colors, color);
+	list_->line_widths.push_back(max(line_width, 1.0f));
+}
+
+void BatchRenderer::add_dotted_line(const Vec2 from, const Vec2 to)
+{
+	if (list_ == nullptr) return;
+
+	list_->dotted_lines.push_back(from.x);
+	list_->dotted_lines.push_back(from.y);
+	list_->dotted_lines.push_back(to.x);
+	list_->dotted_lines.push_back(to.y);
+}
+
+void BatchRenderer::push_color(vector<float>& colors, const ofColor& color) const
+{
+	colors.push_back(color.r / 255.0f);
+	colors.push_back(color.g / 255.0f);
+	colors.push_back(color.b / 255.0f);
+	colors.push_back(color.a / 255.0f);
+}
+
+void BatchRenderer::draw_circles(const BatchList& list)
+{
+	const int count = static_cast<int>(list.circle_instances.size() / 4);
+	if (count == 0) return;
+
+	upload(circle_vbo_, circle_corners, count, {
+		{ instance_attribute, &list.circle_instances, 4 },
+		{ color_attribute, &list.circle_colors, 4 } });
+
+	circle_shader_.begin();
+	circle_shader_.setUniform1f("pixel_size", list.pixel_size);
+	(instancing_supported_) ? circle_vbo_.drawInstanced(GL_TRIANGLES, 0, 6, count) : circle_vbo_.draw(GL_TRIANGLES, 0, 6 * count);
+	circle_shader_.end();
+
+	draw_calls_++;
+}
+
+void BatchRenderer::draw_lines(const BatchList& list)
+{
+	const int count = static_cast<int>(list.line_widths.size());
+	if (count == 0) return;
+
+	upload(line_vbo_, line_corners, count, {
+		{ instance_attribute, &list.line_instances, 4 },
+		{ color_attribute, &list.line_colors, 4 },
+		{ width_attribute, &list.line_widths, 1 } });
+
+	line_shader_.begin();
+	line_shader_.setUniform1f("pixel_size", list.pixel_size);
+	(instancing_supported_) ? line_vbo_.drawInstanced(GL_TRIANGLES, 0, 6, count) : line_vbo_.draw(GL_TRIANGLES, 0, 6 * count);
+	line_shader_.end();
+
+	draw_calls_++;
+}
+
+void BatchRenderer::draw_dotted_lines(const BatchList& list) const
+{
+	if (list.dotted_lines.empty()) return;
+
+	// only ever one or two of these (the player's aim line), fixed function stipple is fine
+	glEnable(GL_LINE_STIPPLE);
+	glLineStipple(8, 0xAAAA);
+	glBegin(GL_LINES);
+	for (size_t i = 0; i + 3 < list.dotted_lines.size(); i += 4)
+	{
+		glVertex3f(list.dotted_lines[i + 0], list.dotted_lines[i + 1], 0);
+		glVertex3f(list.dotted_lines[i + 2], list.dotted_lines[i + 3], 0);
+	}
+	glEnd();
+	glDisable(GL_LINE_STIPPLE);
+}
+
+void BatchRenderer::upload(ofVbo& vbo, const float* corners, const int instance_count, const initializer_list<Attribute> attributes)
+{
+	if (instancing_supported_)
+	{
+		// the corners are already on the gpu (setup), only the instances change
+		for (const auto& attribute : attributes)
+		{
+			vbo.setAttributeData(attribute.location, attribute.data->data(), attribute.components, instance_count, GL_STREAM_DRAW);
+			vbo.setAttributeDivisor(attribute.location, 1);
+		}
+		return;
+	}
+
+	// no instancing - repeat every instance attribute for each of the 6 vertices, still a single draw
+	expanded_corners_.resize(instance_count * 12);
+	for (int i = 0; i < instance_count; i++)
+	{
+		copy(corners, corners + 12, expanded_corners_.begin() + i * 12);
+	}
+	vbo.setVertexData(expanded_corners_.data(), 2, instance_count * 6, GL_STREAM_DRAW);
+
+	expanded_attributes_.resize(attributes.size());
+	int a = 0;
+	for (const auto& attribute : attributes)
+	{
+		vector<float>& expanded = expanded_attributes_[a++];
+		const int components = attribute.components;
+		expanded.resize(instance_count * 6 * components);
+		for (int i = 0; i < instance_count; i++)
+		{
+			const float* src = attribute.data->data() + i * components;
+			for (int v = 0; v < 6; v++)
+			{
+				copy(src, src + components, expanded.begin() + (i * 6 + v) * components);
+			}
+		}
+		vbo.setAttributeData(attribute.location, expanded.data(), components, instance_count * 6, GL_STREAM_DRAW);
+		vbo.setAttributeDivisor(attribute.location, 0);
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ofMain.h"
+#include "core/Vec2.h"
+
+// one frame's worth of entity shapes - plain arrays, so it can be filled on the simulation thread and drawn later on the GL thread
+struct BatchList {
+
+	void clear();
+
+	float pixel_size = 1; // world units per screen pixel when the list was recorded
+
+	// circles: x, y, diameter, ring width in pixels (0 = filled) + rgba
+	vector<float> circle_instances;
+	vector<float> circle_colors;
+
+	// lines: from x/y, to x/y + rgba + width in pixels
+	vector<float> line_instances;
+	vector<float> line_colors;
+	vector<float> line_widths;
+
+	// dotted guide lines: from x/y, to x/y
+	vector<float> dotted_lines;
+};
+
+// collects every entity circle/outline/line for a frame and draws them with one instanced draw per primitive type
+// circles are evaluated in the fragment shader (no polygon tessellation), sizes are diameters just like ofDrawEllipse
+// recording (begin/add/end) doesn't touch GL, only draw() does
+class BatchRenderer {
+
+public:
+
+	BatchRenderer();
+
+	void setup();
+
+	void begin(BatchList& list, float world_units_per_pixel);
+	void end();
+
+	void draw(const BatchList& list);
+
+	void add_fill(Vec2 pos, float size, const ofColor& color);
+	void add_outline(Vec2 pos, float size, float line_width, const ofColor& color);
+	void add_line(Vec2 from, Vec2 to, float line_width, const ofColor& color);
+	void add_dotted_line(Vec2 from, Vec2 to);
+
+	int get_draw_calls() const { return draw_calls_; }
+	bool is_instanced() const { return instancing_supported_; }
+
+private:
+
+	void push_color(vector<float>& colors, const ofColor& color) const;
+
+	void draw_circles(const BatchList& list);
+	void draw_lines(const BatchList& list);
+	void draw_dotted_lines(const BatchList& list) const;
+
+	struct Attribute {
+		int location;
+		const vector<float>* data;
+		int components;
+	};
+
+	// uploads per-instance attributes, or expands them (and the corners) per-vertex when instancing isn't available
+	void upload(ofVbo& vbo, const float* corners, int instance_count, initializer_list<Attribute> attributes);
+
+	ofShader circle_shader_;
+	ofShader line_shader_;
+
+	ofVbo circle_vbo_;
+	ofVbo line_vbo_;
+
+	bool is_setup_;
+	bool instancing_supported_;
+
+	BatchList* list_; // list being recorded into, null outside begin/end
+	int draw_calls_;
+
+	// scratch space for the non-instanced fallback
+	vector<float> expanded_corners_;
+	vector<vector<float>> expanded_attributes_;
+
+};
@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+
+void Benchmark::begin_run(const int frames_per_scene, const int seed, const int worker_count)
+{
+	frames_per_scene_ = frames_per_scene;
+	seed_ = seed;
+	worker_count_ = worker_count;
+	results_.clear();
+}
+
+void Benchmark::begin_scene(const string& name, const int entity_count)
+{
+	scene_name_ = name;
+	entity_count_ = entity_count;
+	samples_.clear();
+}
+
+void Benchmark::add_sample(const string& subsystem, const float ms)
+{
+	for (auto& samples : samples_)
+	{
+		if (samples.first == subsystem)
+		{
+			samples.second.push_back(ms);
+			return;
+		}
+	}
+
+	samples_.push_back({ subsystem, { ms } });
+	samples_.back().second.reserve(frames_per_scene_);
+}
+
+void Benchmark::end_scene()
+{
+	SceneResult result;
+	result.name = scene_name_;
+	result.entity_count = entity_count_;
+
+	cout << "------------Benchmark.cpp------------" << endl;
+	cout << " [ " << scene_name_ << " ] " << entity_count_ << " entities" << endl;
+	for (auto& samples : samples_)
+	{
+		const Stats stats = summarise(samples.second);
+		result.subsystems.push_back({ samples.first, stats });
+
+		cout << " - " << samples.first << ": mean " << ofToString(stats.mean, 3) << "ms, p50 " << ofToString(stats.p50, 3) << "ms, p99 " << ofToString(stats.p99, 3) << "ms, max " << ofToString(stats.max, 3) << "ms" << endl;
+	}
+	cout << "-------------------------------------" << endl;
+
+	results_.push_back(result);
+	samples_.clear();
+}
+
+bool Benchmark::save(const string& path) const
+{
+	ofJson json;
+	json["date"] = ofGetTimestampString("%Y-%m-%d %H:%M:%S");
+	json["frames_per_scene"] = frames_per_scene_;
+	json["seed"] = seed_;
+	json["workers"] = worker_count_;
+
+	ofJson scenes = ofJson::array();
+	for (auto& result : results_)
+	{
+		ofJson scene;
+		scene["name"] = result.name;
+		scene["entities"] = result.entity_count;
+
+		ofJson subsystems = ofJson::object();
+		for (auto& subsystem : result.subsystems)
+		{
+			ofJson stats;
+			stats["mean"] = subsystem.second.mean;
+			stats["p50"] = subsystem.second.p50;
+			stats["p99"] = subsystem.second.p99;
+			stats["max"] = subsystem.second.max;
+			subsystems[subsystem.first] = stats;
+		}
+		scene["subsystems_ms"] = subsystems;
+
+		scenes.push_back(scene);
+	}
+	json["scenes"] = scenes;
+
+	const bool saved = ofSavePrettyJson(path, json);
+	cout << ((saved) ? " - Benchmark saved to " : "Error: Couldn't save benchmark to ") << path << endl;
+	return saved;
+}
+
+Benchmark::Stats Benchmark::summarise(vector<float> samples)
+{
+	Stats stats;
+	if (samples.empty()) return stats;
+
+	sort(samples.begin(), samples.end());
+
+	double total = 0;
+	for (const float sample : samples)
+	{
+		total += sample;
+	}
+
+	stats.mean = static_cast<float>(total / samples.size());
+	stats.p50 = percentile(samples, 0.5f);
+	stats.p99 = percentile(samples, 0.99f);
+	stats.max = samples.back();
+	return stats;
+}
+
+// nearest rank
+float Benchmark::percentile(const vector<float>& sorted, const float p)
+{
+	const int rank = static_cast<int>(ceil(p * sorted.size()));
+	return sorted[ofClamp(rank - 1, 0, static_cast<int>(sorted.size()) - 1)];
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ofMain.h"
+
+// per-subsystem step timings for the scene replay benchmark (--benchmark)
+// samples are kept per scene and summarised as mean/p50/p99/max, the whole run is written out as json so runs can be compared over time
+class Benchmark {
+
+public:
+
+	void begin_run(int frames_per_scene, int seed, int worker_count);
+
+	void begin_scene(const string& name, int entity_count);
+	void add_sample(const string& subsystem, float ms);
+	void end_scene();
+
+	bool save(const string& path) const;
+
+private:
+
+	struct Stats {
+		float mean = 0;
+		float p50 = 0;
+		float p99 = 0;
+		float max = 0;
+	};
+
+	struct SceneResult {
+		string name;
+		int entity_count;
+		vector<pair<string, Stats>> subsystems;
+	};
+
+	static Stats summarise(vector<float> samples);
+	static float percentile(const vector<float>& sorted, float p);
+
+	int frames_per_scene_ = 0;
+	int seed_ = -1;
+	int worker_count_ = 0;
+
+	string scene_name_;
+	int entity_count_ = 0;
+	vector<pair<string, vector<float>>> samples_; // kept in the order the subsystems are first reported
+
+	vector<SceneResult> results_;
+
+};
@@ -0,0 +1,131 @@
+#include "CachedPanel.h"
+
+CachedPanel::CachedPanel()
+	:	panel_(nullptr)
+	,	dirty_(true)
+{
+}
+
+CachedPanel::~CachedPanel()
+{
+	if (panel_ != nullptr) ofRemoveListener(panel_->getParameter().castGroup().parameterChangedE(), this, &CachedPanel::on_parameter_changed);
+}
+
+void CachedPanel::setup(ofxPanel* panel)
+{
+	panel_ = panel;
+	dirty_ = true;
+
+	// child parameters notify their group, so this catches slider drags, toggles and label updates alike
+	ofAddListener(panel_->getParameter().castGroup().parameterChangedE(), this, &CachedPanel::on_parameter_changed);
+}
+
+void CachedPanel::on_parameter_changed(ofAbstractParameter& parameter)
+{
+	dirty_ = true;
+}
+
+void CachedPanel::draw()
+{
+	if (panel_ == nullptr) return;
+
+	const int width = static_cast<int>(ceil(panel_->getWidth()));
+	const int height = static_cast<int>(ceil(panel_->getHeight()));
+	if (width <= 0 || height <= 0) return;
+
+	if (!cache_.isAllocated() || cache_.getWidth() != width || cache_.getHeight() != height)
+	{
+		cache_.allocate(width, height, GL_RGBA);
+		dirty_ = true;
+	}
+
+	// cleared before rendering, so a parameter changed mid-render dirties the panel again for the next frame
+	if (dirty_.exchange(false))
+	{
+		render();
+#if CACHED_PANEL_VERIFY
+		verify();
+#endif
+	}
+
+	const glm::vec3 pos = panel_->getPosition();
+	composite(round(pos.x), round(pos.y));
+}
+
+void CachedPanel::render()
+{
+	const glm::vec3 pos = panel_->getPosition();
+
+	cache_.begin();
+	ofClear(0, 0);
+	ofPushStyle();
+	// colour is blended as usual, alpha accumulates as coverage - what ends up in the cache is premultiplied
+	// ofxGui only sets its own blend function when the style's blend mode isn't already alpha
+	ofEnableBlendMode(OF_BLENDMODE_ALPHA);
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	ofPushMatrix();
+	ofTranslate(-round(pos.x), -round(pos.y));
+	panel_->draw();
+	ofPopMatrix();
+	ofPopStyle();
+	cache_.end();
+}
+
+void CachedPanel::composite(const float x, const float y)
+{
+	ofPushStyle();
+	ofSetColor(255);
+	ofEnableBlendMode(OF_BLENDMODE_ALPHA);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);	// the colour is already multiplied by its alpha
+	cache_.draw(x, y);
+	ofPopStyle();
+}
+
+#if CACHED_PANEL_VERIFY
+void CachedPanel::verify()
+{
+	const glm::vec3 pos = panel_->getPosition();
+	const int width = static_cast<int>(cache_.getWidth());
+	const int height = static_cast<int>(cache_.getHeight());
+
+	// both over the same opaque backdrop, one from the cache and one drawn the way it would be without it
+	ofFbo cached;
+	ofFbo direct;
+	cached.allocate(width, height, GL_RGBA);
+	direct.allocate(width, height, GL_RGBA);
+
+	cached.begin();
+	ofClear(40, 80, 120, 255);
+	composite(0, 0);
+	cached.end();
+
+	direct.begin();
+	ofClear(40, 80, 120, 255);
+	ofPushMatrix();
+	ofTranslate(-round(pos.x), -round(pos.y));
+	panel_->draw();
+	ofPopMatrix();
+	direct.end();
+
+	ofPixels cached_pixels;
+	ofPixels direct_pixels;
+	cached.readToPixels(cached_pixels);
+	direct.readToPixels(direct_pixels);
+
+	// colour only, the backdrop's alpha isn't what ends up on screen
+	int max_difference = 0;
+	int differing_pixels = 0;
+	const size_t channels = cached_pixels.getNumChannels();
+	for (size_t i = 0; i + 2 < cached_pixels.size(); i += channels)
+	{
+		int difference = 0;
+		for (size_t c = 0; c < 3; c++) difference = max(difference, abs(cached_pixels[i + c] - direct_pixels[i + c]));
+		if (difference > 1) differing_pixels++;
+		max_difference = max(max_difference, difference);
+	}
+
+	cout << "------------CachedPanel.cpp------------" << endl;
+	cout << " - " << panel_->getName() << ": " << differing_pixels << " pixels differ from a direct draw, largest difference " << max_difference << endl;
+	cout << "---------------------------------------" << endl;
+}
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxGui.h"
+
+#include <atomic>
+
+#ifndef CACHED_PANEL_VERIFY
+#define CACHED_PANEL_VERIFY		0		// 1 (-DCACHED_PANEL_VERIFY=1) compares every re-render against a direct draw of the panel and logs the largest difference
+#endif
+
+// draws an ofxPanel from an offscreen copy that's only re-rendered when one of its parameters changes, or it's resized (minimised)
+// moving the panel doesn't dirty it - the cached image is simply drawn at the panel's current position
+// the cache holds premultiplied colour, so compositing it applies the panel's alpha once, the same as drawing the panel directly
+class CachedPanel {
+
+public:
+
+	CachedPanel();
+	~CachedPanel();
+
+	void setup(ofxPanel* panel);
+
+	void draw();
+	void mark_dirty() { dirty_ = true; }
+
+private:
+
+	void on_parameter_changed(ofAbstractParameter& parameter);
+	void render();
+	void composite(float x, float y);
+#if CACHED_PANEL_VERIFY
+	void verify();
+#endif
+
+	ofxPanel* panel_;
+	ofFbo cache_;
+	std::atomic<bool> dirty_;		// set from whichever thread changes a parameter, cleared by draw() on the main thread
+
+};
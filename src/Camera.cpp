@@ -6,6 +6,9 @@ Camera::Camera()
 	,	scale_(1)
 	,	follow_player_(true)
 	,	prev_player_view_scale_(1)
+	,	visible_world_rect_(0, 0, world::WORLD_WIDTH, world::WORLD_HEIGHT)
+	,	render_scale_(1)
+	,	frame_(0)
 	,	zooming_out_(false)
 	,	zooming_in_(false)
 	,	keyboard_zooming_speed_(0.025f)
@@ -23,25 +26,45 @@ Camera::Camera()
 	cam_.removeAllInteractions();
 }
 
-void Camera::update(const ofVec2f player_pos)
+void Camera::update(const ofVec2f player_pos, const StepInput& input)
 {
-	calculate_mouse_coords();	
+	frame_ = input.frame;
+	calculate_mouse_coords(input);
 	handle_position(player_pos);
 	handle_scale();
+	calculate_visible_world_rect();
 }
 
-void Camera::calculate_mouse_coords()
+void Camera::calculate_visible_world_rect()
+{
+	// the ortho projection is centred on the camera node and every screen pixel covers 'node scale' world units
+	const ofVec3f cam_pos = cam_.getPosition();
+	const float units_per_pixel = cam_.getScale().x;
+	visible_world_rect_.setFromCenter(cam_pos.x, cam_pos.y, ofGetWidth() * units_per_pixel, ofGetHeight() * units_per_pixel);
+}
+
+ofRectangle Camera::get_visible_world_rect(const float margin) const
+{
+	ofRectangle rect = visible_world_rect_;
+	rect.x -= margin;
+	rect.y -= margin;
+	rect.width += margin * 2;
+	rect.height += margin * 2;
+	return rect;
+}
+
+void Camera::calculate_mouse_coords(const StepInput& input)
 {
 	const float mult = ofGetHeight() / 1080.0f;
 	
 	// calculate local + world mouse positions	
-	const ofVec3f local_pos = ofVec3f(ofGetMouseX() - HALF_WORLD_WIDTH, ofGetMouseY() - HALF_WORLD_HEIGHT, 0);
+	const ofVec3f local_pos = ofVec3f(input.mouse_x - world::HALF_WORLD_WIDTH, input.mouse_y - world::HALF_WORLD_HEIGHT, 0);
 	
 	ofVec3f world_pos = screen_to_world(local_pos);
-	world_pos.x += WORLD_WIDTH * ofMap(get_scale() / mult, 1.0f, 3.0f, 0.0f, 1.0f);
-	world_pos.y += WORLD_HEIGHT * ofMap(get_scale() / mult, 1.0f, 3.0f, 0.0f, 1.0f);
+	world_pos.x += world::WORLD_WIDTH * ofMap(get_scale() / mult, 1.0f, 3.0f, 0.0f, 1.0f);
+	world_pos.y += world::WORLD_HEIGHT * ofMap(get_scale() / mult, 1.0f, 3.0f, 0.0f, 1.0f);
 
-	local_mouse_pos_ = ofVec2f(ofGetMouseX() / 2 - ofGetWidth() / 2, ofGetMouseY() - ofGetHeight() / 2);
+	local_mouse_pos_ = ofVec2f(input.mouse_x / 2 - input.window_width / 2, input.mouse_y - input.window_height / 2);
 	world_mouse_pos_ = world_pos;
 }
 
@@ -64,14 +87,14 @@ void Camera::follow_player(const ofVec2f player_pos)
 	{
 		if (view_ == Cam_modes_::player_view)
 		{
-			if (ofGetFrameNum() > 0) { // <-- otherwise the cam briefly stutters on game launch
+			if (frame_ > 0) { // <-- otherwise the cam briefly stutters on game launch
 				pos_to_lerp_to_.set(ofVec2f(player_pos.x, player_pos.y));
 				lerping_position_ = true;
 			}
 		}
 		else if (view_ == Cam_modes_::map_view)
 		{
-			pos_to_lerp_to_.set(ofVec2f(0 + HALF_WORLD_WIDTH, 0 + HALF_WORLD_HEIGHT));
+			pos_to_lerp_to_.set(ofVec2f(0 + world::HALF_WORLD_WIDTH, 0 + world::HALF_WORLD_HEIGHT));
 			lerping_position_ = true;
 		}
 	}
@@ -322,13 +345,37 @@ void Camera::set_scale(const float scale)
 	scale_ = scale;
 }
 
+float Camera::get_world_units_per_pixel() const
+{
+	// matches the node scale set in handle_scale(), pixels are render target pixels while rendering at a reduced scale
+	const float mult = ofGetHeight() / 1080.0f;
+	return get_scale() / mult / render_scale_;
+}
+
+void Camera::set_render_scale(const float render_scale)
+{
+	render_scale_ = render_scale;
+}
+
 void Camera::begin()
 {
 	cam_.begin();
+
+	// a smaller render target shows less of the world through the ortho projection, compensate by scaling the world about the camera so the framing stays the same
+	// the camera node itself is left alone, the simulation thread reads its matrices while the world is drawn
+	if (render_scale_ != 1)
+	{
+		const ofVec3f cam_pos = cam_.getPosition();
+		ofPushMatrix();
+		ofTranslate(cam_pos.x, cam_pos.y);
+		ofScale(render_scale_, render_scale_);
+		ofTranslate(-cam_pos.x, -cam_pos.y);
+	}
 }
 
 void Camera::end()
 {
+	if (render_scale_ != 1) ofPopMatrix();
 	cam_.end();
 }
 
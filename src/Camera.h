@@ -2,6 +2,7 @@
 
 #include "ofMain.h"
 #include "Controller.h"
+#include "core/StepInput.h"
 
 class Camera {
 
@@ -9,8 +10,10 @@ public:
 	
 	Camera();
 	
-	void update(ofVec2f player_pos);
-	void calculate_mouse_coords();
+	// input is the world's latched mouse and frame, the same the entity step gets
+	void update(ofVec2f player_pos, const StepInput& input);
+	void calculate_mouse_coords(const StepInput& input);
+	void calculate_visible_world_rect();
 	void follow_player(ofVec2f player_pos);
 
 	// Position/scale handling + interpolation
@@ -27,6 +30,8 @@ public:
 	void set_zoom_mode(const Cam_modes_ view);
 	void toggle_zoom_mode();
 
+	// render target pixels per window pixel, set once per frame before the world pass
+	void set_render_scale(float render_scale);
 	void begin();
 	void end();
 	
@@ -46,6 +51,10 @@ public:
 	void set_position(ofVec2f pos);
 	float get_scale() const;
 	void set_scale(float scale);
+	float get_world_units_per_pixel() const;
+
+	// area of the world (0..WORLD_WIDTH/HEIGHT) currently on screen, updated once per frame
+	ofRectangle get_visible_world_rect(float margin = 0) const;
 
 	// Draw Frustram
 	void draw() const;
@@ -70,6 +79,10 @@ private:
 	bool follow_player_;
 	float prev_player_view_scale_;
 	
+	ofRectangle visible_world_rect_;
+	float render_scale_;
+	uint64_t frame_;
+
 	ofVec3f local_mouse_pos_;
 	ofVec3f world_mouse_pos_;
 	
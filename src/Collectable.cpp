@@ -13,7 +13,7 @@ Collectable::Collectable(const ofVec2f pos, const float mass, const float radius
 	,	id_(get_cur_id())
 {
 	set_type("Collectable");
-	set_position(pos);
+	set_position(Vec2(pos));
 	set_color(ofColor(passive_color_.r, passive_color_.g, passive_color_.b, 100));
 	set_mass(mass);
 	set_radius(radius);
@@ -35,46 +35,24 @@ Collectable::Collectable(const ofVec2f pos, const float mass, const float radius
 	// incase a point is added in sandbox mode and is enabled by default
 	if (is_active_)
 	{
-		Collectable::points_collected_++;
-		last_id_collected_ = id_;
+		CollectableProgress& progress = WorldContext::current().collectables;
+		progress.points_collected++;
+		progress.last_id_collected = id_;
 		can_be_collected_ = false;
 	}		
 }
 
-Collectable::Collectable(const ofVec2f pos, const float mass, const float radius, const bool is_active)
-	: Collectable(pos, mass, ofRandom(15, 100), static_cast<int>(ofRandom(75, 100)), 0.1f, is_active)
-{}
+Collectable::~Collectable() = default;
 
 
 
-// Static vars
-
-bool Collectable::first_point_ = true;
-int Collectable::last_id_collected_ = -404;
-int Collectable::cur_id_ = -1;
-int Collectable::collectable_count_ = 0;
-
-bool Collectable::first_point()
-{
-	if (Collectable::first_point_)
-	{
-		return true;
-	}
-	else
-	{
-		return false;
-	}
-}
 int Collectable::get_cur_id()
 {
-	collectable_count_++;
-	
-	cur_id_++;
-	return cur_id_;
+	CollectableProgress& progress = WorldContext::current().collectables;
+	progress.collectable_count++;
+	return ++progress.cur_id;
 }
 
-int Collectable::points_collected_ = 0;
-
 
 
 void Collectable::update()
@@ -102,41 +80,51 @@ bool Collectable::can_emit() const
 	return false;
 }
 
-// collectables randomly emit 'shock waves' which in effect causes 'streams' of particles to form (this could help the player to locate collectables)
-void Collectable::emit_forces()
+void Collectable::compute_interactions()
 {
-	if (ofGetFrameNum() % static_cast<int>(emission_frequency_) == 0)
+	// only needed on the frames emit_forces fires
+	if (step_input_->frame % static_cast<int>(emission_frequency_) != 0) return;
+
+	// scratch for this step only
+	Vec2* point_positions = FrameArena::allocate<Vec2>(game_objects_->size());
+	int point_count = 0;
+	for (auto& game_object : *game_objects_)
 	{
-		vector<ofVec2f> point_positions;		
-		for (auto& game_object : *game_objects_)
+		if (game_object->get_type() == "Collectable")
 		{
-			if (game_object->get_type() == "Collectable")
-			{
-				point_positions.push_back(game_object->get_position());
-			}
+			point_positions[point_count++] = game_object->get_body().pos;
 		}
+	}
 
-		ofVec2f vel;
-		for (int i = 0; i < point_positions.size(); i++)
+	emission_direction_ = Vec2();
+	for (int i = 0; i < point_count; i++)
+	{
+		if (point_positions[i] == body_.pos)
 		{
-			if (point_positions[i] == get_position())
-			{
-				int i2;
-				if (i + 1 == point_positions.size())
-					i2 = 0;
-				else
-					i2 = i + 1;
-
-				vel = (point_positions[i2] - point_positions[i]);
-				vel.normalize();
-			}
-		}		
-		
+			int i2;
+			if (i + 1 == point_count)
+				i2 = 0;
+			else
+				i2 = i + 1;
+
+			emission_direction_ = (point_positions[i2] - point_positions[i]).normalized();
+		}
+	}
+}
+
+// collectables randomly emit 'shock waves' which in effect causes 'streams' of particles to form (this could help the player to locate collectables)
+void Collectable::emit_forces()
+{
+	if (step_input_->frame % static_cast<int>(emission_frequency_) == 0)
+	{
+		const ofVec2f vel = emission_direction_.to<ofVec2f>();
+
+		RandomStream& random = Random::get(RANDOM_ENTITIES);
 		for (int i = 0; i < 100; i++)
 		{
 			ofVec2f mapped_pos;
-			mapped_pos.x = ofMap(get_position().x + ofRandom(-starting_radius_ * 0.8f, starting_radius_ * 0.8f), -HALF_WORLD_WIDTH, HALF_WORLD_WIDTH, 0, 1);
-			mapped_pos.y = ofMap(get_position().y + ofRandom(-starting_radius_ * 0.8f, starting_radius_ * 0.8f), -HALF_WORLD_HEIGHT, HALF_WORLD_HEIGHT, 0, 1);
+			mapped_pos.x = ofMap(get_position().x + random.range(-starting_radius_ * 0.8f, starting_radius_ * 0.8f), -world::HALF_WORLD_WIDTH, world::HALF_WORLD_WIDTH, 0, 1);
+			mapped_pos.y = ofMap(get_position().y + random.range(-starting_radius_ * 0.8f, starting_radius_ * 0.8f), -world::HALF_WORLD_HEIGHT, world::HALF_WORLD_HEIGHT, 0, 1);
 			
 			fluid_manager_->add_to_fluid(mapped_pos, vel * emission_force_ * 0.01f, true, true, 1);
 		}
@@ -172,23 +160,25 @@ void Collectable::pulse_radius()
 
 void Collectable::check_if_active()
 {	
+	CollectableProgress& progress = WorldContext::current().collectables;
+
 	if (!is_active_)
 	{
 		if (gamemode_manager_->get_current_mode_string() == "Procedural" && id_ == 0)
 		{
-			Collectable::points_collected_++;
+			progress.points_collected++;
 			is_active_ = true;
-			last_id_collected_ = id_;
+			progress.last_id_collected = id_;
 			can_be_collected_ = false;
 			make_active_on_next_emission_ = false;
 		}
 		else
 		{
 			int next_id;
-			if (last_id_collected_ == collectable_count_ - 1)
+			if (progress.last_id_collected == progress.collectable_count - 1)
 				next_id = 0;
 			else
-				next_id = last_id_collected_ + 1;
+				next_id = progress.last_id_collected + 1;
 
 			if (id_ == next_id)
 			{
@@ -203,13 +193,13 @@ void Collectable::check_if_active()
 	{
 		is_active_ = true;
 		
-		if (id_ == Collectable::collectable_count_ - 1)
+		if (id_ == progress.collectable_count - 1)
 			gui_manager_->gui_world_activate_all_points = false;
 	}
 	else if (gui_manager_->gui_world_deactivate_all_points)
 	{
 		is_active_ = false;
-		if (id_ == Collectable::collectable_count_ - 1)
+		if (id_ == progress.collectable_count - 1)
 			gui_manager_->gui_world_deactivate_all_points = false;
 	}
 }
@@ -218,13 +208,12 @@ void Collectable::check_if_active()
 
 void Collectable::update_forces()
 {
-	add_forces(false);
+	body_.add_forces();
 }
 
 void Collectable::drag_nodes()
 {
 	local_mouse_pos_before_drag_.set(cam_->get_local_mouse_pos());
-	static ofVec2f mouse_pos_before_drag;
 	
 	if (mouse_drag_)
 	{
@@ -235,22 +224,22 @@ void Collectable::drag_nodes()
 		
 		const ofVec2f prev_pos2 = ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y)/* + mouse_offset_from_center_*/;
 
-		ofVec2f new_pos;
-		new_pos.x = ofLerp(pos_.x, prev_pos2.x, 0.1f);
-		new_pos.y = ofLerp(pos_.y, prev_pos2.y, 0.1f);
+		Vec2 new_pos;
+		new_pos.x = ofLerp(body_.pos.x, prev_pos2.x, 0.1f);
+		new_pos.y = ofLerp(body_.pos.y, prev_pos2.y, 0.1f);
 
 		set_position(new_pos);
-		set_velocity(ofVec2f(0));
+		set_velocity(Vec2());
 		
-		mouse_pos_before_drag = ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y);
+		world_mouse_pos_before_drag_ = ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y);
 	}
 	else
 	{
 		if (started_dragging_ == true)
 		{
 			started_dragging_ = false;
-			const ofVec2f mouse_speed = (ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y) - mouse_pos_before_drag) / 3;
-			apply_force(accel_, mouse_speed, false);
+			const ofVec2f mouse_speed = (ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y) - world_mouse_pos_before_drag_) / 3;
+			body_.apply_force(body_.accel, Vec2(mouse_speed), false);
 		}
 	}
 }
@@ -261,12 +250,12 @@ void Collectable::update_gui()
 	{
 		if (gui_values_need_to_be_set_)
 		{
-			gui_manager_->update_collectable_values(pos_, vel_, accel_, starting_radius_, emission_frequency_, emission_force_, is_active_, id_);
+			gui_manager_->update_collectable_values(body_.pos, body_.vel, body_.accel, starting_radius_, emission_frequency_, emission_force_, is_active_, id_);
 			gui_values_need_to_be_set_ = false;
 		}
 		else
 		{
-			gui_manager_->update_collectable_values(pos_, vel_, accel_, gui_manager_->gui_collectable_radius, gui_manager_->gui_collectable_emission_frequency, gui_manager_->gui_collectable_emission_force, gui_manager_->gui_collectable_is_active, id_);
+			gui_manager_->update_collectable_values(body_.pos, body_.vel, body_.accel, gui_manager_->gui_collectable_radius, gui_manager_->gui_collectable_emission_frequency, gui_manager_->gui_collectable_emission_force, gui_manager_->gui_collectable_is_active, id_);
 			starting_radius_ = gui_manager_->gui_collectable_radius;
 			emission_frequency_ = gui_manager_->gui_collectable_emission_frequency;
 			emission_force_ = gui_manager_->gui_collectable_emission_force;
@@ -277,10 +266,10 @@ void Collectable::update_gui()
 
 void Collectable::reset_forces()
 {
-	accel_.set(0);
+	body_.accel = Vec2();
 }
 
-void Collectable::is_colliding(GameObject* other, ofVec2f node_pos)
+void Collectable::is_colliding(GameObject* other, const Vec2 other_pos)
 {
 	if ((gamemode_manager_->get_current_mode_string() == "Sandbox" && gui_manager_->gui_world_enable_points_in_range) || gamemode_manager_->get_current_mode_string() != "Sandbox")
 	{
@@ -288,13 +277,14 @@ void Collectable::is_colliding(GameObject* other, ofVec2f node_pos)
 		{
 			if (can_be_collected_/* || Collectable::first_point()*/)
 			{
-				first_point_ = false;
+				CollectableProgress& progress = WorldContext::current().collectables;
+				progress.first_point = false;
 				can_be_collected_ = false;
 
 				make_active_on_next_emission_ = true;
 				alpha_ = 255;
-				Collectable::last_id_collected_ = id_;
-				Collectable::points_collected_++;				
+				progress.last_id_collected = id_;
+				progress.points_collected++;
 			}
 		}
 	}
@@ -323,7 +313,7 @@ void Collectable::mouse_dragged(const float x, const float y, const int button)
 	{
 		if (mouse_over_ && game_controller_->get_mouse_dragged() == false)
 		{
-			if (local_mouse_pos_before_drag_.distance(ofVec2f(ofGetMouseX() / 2 - ofGetWidth() / 2, ofGetMouseY() - ofGetHeight() / 2)) > pixel_buffer_before_drag_)
+			if (local_mouse_pos_before_drag_.distance(ofVec2f(step_input_->mouse_x / 2 - step_input_->window_width / 2, step_input_->mouse_y - step_input_->window_height / 2)) > pixel_buffer_before_drag_)
 			{
 				// the node will only be moved by the mouse if it has been moved by more than 1 pixel - this prevents accidentally stopping something by selecting it
 				mouse_drag_ = true;
@@ -351,21 +341,15 @@ void Collectable::mouse_released(const float x, const float y, const int button)
 
 void Collectable::draw()
 {
-	ofPushStyle();
-	
 	draw_fill();
 	draw_outline();
-
-	ofPopStyle();
 }
 
 void Collectable::draw_fill()
 {
 	if (is_active_)
 	{
-		ofSetColor(ofColor(0, 0, 0, 50));
-		ofFill();
-		ofDrawEllipse(pos_.x, pos_.y, radius_, radius_);
+		batch_renderer_->add_fill(body_.pos, body_.radius, ofColor(0, 0, 0, 50));
 	}
 }
 
@@ -377,8 +361,8 @@ void Collectable::draw_outline()
 		float r;
 		if (is_active_)
 		{
-			alpha_ = ofMap(radius_, starting_radius_, starting_radius_ * 2, 0, 255);
-			r = radius_;
+			alpha_ = ofMap(body_.radius, starting_radius_, starting_radius_ * 2, 0, 255);
+			r = body_.radius;
 		}
 		else
 		{
@@ -392,29 +376,24 @@ void Collectable::draw_outline()
 
 		if (gamemode_manager_->get_current_mode_string() == "Sandbox" && !is_active_)
 		{
-			(can_be_collected_) ? ofSetColor(0, 255, 0) : ofSetColor(255, 0, 0);
-			ofSetLineWidth(0.05f);
+			batch_renderer_->add_outline(body_.pos, r, 0.05f, (can_be_collected_) ? ofColor(0, 255, 0) : ofColor(255, 0, 0));
 		}
 		else
 		{
 			(is_active_) ? set_color(ofColor(0, 255, 0)) : set_color(ofColor(255, 0, 0));
-			get_color();
-			ofSetLineWidth(ofMap(radius_, starting_radius_, starting_radius_ * 2, 0.1f, 2.0f));
+			batch_renderer_->add_outline(body_.pos, r, ofMap(body_.radius, starting_radius_, starting_radius_ * 2, 0.1f, 2.0f), get_color());
 		}
-
-		ofNoFill();
-		ofDrawEllipse(pos_.x, pos_.y, r, r);
 	}
 }
 
-void Collectable::get_color() const
+ofColor Collectable::get_color() const
 {
 	if ((gamemode_manager_->get_current_mode_string() == "Sandbox") && ((get_is_selected() == true) || (mouse_over_ || mouse_drag_)))
 	{
-		ofSetColor(selected_color_);
+		return selected_color_;
 	}
 	else
 	{
-		ofSetColor(ofColor(color_.r, color_.g, color_.b, alpha_));
+		return ofColor(color_.r, color_.g, color_.b, alpha_);
 	}
 }
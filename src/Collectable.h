@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ofMain.h"
+#include "core/FrameArena.h"
+#include "core/WorldContext.h"
 #include "GameObject.h"
 #include "PlayerTrail.h"
 #include "Mass.h"
@@ -10,25 +12,21 @@ class Collectable : public GameObject {
 public:
 
 	Collectable(ofVec2f pos, float mass, float radius, float emission_frequency, float emission_force, bool is_active);
-	Collectable(ofVec2f pos, float mass, float radius, bool is_active);
 
 	~Collectable();
 
+	// the collectable chain is per world, these act on the current one
 	static void reset_ids()
 	{
-		first_point_ = true;
-		last_id_collected_ = -404;
-		cur_id_ = -1;
-		points_collected_ = 0;
-		collectable_count_ = 0;
+		WorldContext::current().collectables.reset();
 	}
 	static int get_points_collected()
 	{
-		return points_collected_;
+		return WorldContext::current().collectables.points_collected;
 	}
 	static void set_points_collected(const int count)
 	{
-		Collectable::points_collected_ = count;
+		WorldContext::current().collectables.points_collected = count;
 	}
 
 private:
@@ -49,7 +47,7 @@ private:
 	void draw_fill();
 	void draw_outline();
 
-	void get_color() const;
+	ofColor get_color() const;
 
 	// Events
 	void mouse_pressed(float x, float y, int button) override;
@@ -57,8 +55,9 @@ private:
 	void mouse_released(float x, float y, int button) override;	
 
 	// Collisions (pull range)
-	void is_colliding(GameObject* other, ofVec2f node_pos = { 0, 0 }) override;
+	void is_colliding(GameObject* other, Vec2 other_pos) override;
 
+	void compute_interactions() override;
 	void emit_forces();
 	void pulse_radius();
 	void check_if_active();
@@ -79,7 +78,6 @@ private:
 			return -1;
 	}	
 
-	static bool first_point();
 	static int get_cur_id();
 	
 	
@@ -91,19 +89,13 @@ private:
 	float starting_radius_;
 	bool needs_to_pulse_radius_;
 	bool player_within_bounds_;
+	Vec2 emission_direction_; // towards the next collectable in the list, found in the compute phase
 
 	//vector<PlayerTrail*>* particles_;
 	float alpha_;
 	bool can_be_collected_;
-	static bool first_point_;
 
 	bool inc_alpha_;
 	
 	int id_{};
-	static int last_id_collected_;
-
-	static int cur_id_;
-	static int collectable_count_;
-
-	static int points_collected_;
 };
\ No newline at end of file
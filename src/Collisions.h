@@ -1,11 +0,0 @@
-#pragma once
-
-#include "ofMain.h"
-
-class Collisions
-{
-
-public:
-	static bool ellipse_compare(ofVec2f pos1, float r1, ofVec2f pos2, float r2);
-
-};
\ No newline at end of file
@@ -1,32 +1,7 @@
 #pragma once
 
 #include "ofMain.h"
-
-#define MINIMUM_MASS 1
-#define MAXIMUM_MASS 5000
-
-#define MASS_LOWER_BOUND 250
-#define MASS_UPPER_BOUND 2500
-
-#define RADIUS_MINIMUM 15
-#define RADIUS_MAXIMUM 500
-
-#define RADIUS_LOWER_BOUND 25
-#define RADIUS_UPPER_BOUND 250
-
-#define MAXIMUM_ACCELERATION 0.15f // 0.15
-#define MAXIMUM_VELOCITY 100 // 15
-
-#define FRICTION_FORCE 0.015f
-#define GRAVITY_FORCE 0.0001f
-
-#define WORLD_WIDTH (2000 * 2)
-#define WORLD_HEIGHT (1500 * 2)
-
-#define HALF_WORLD_WIDTH (WORLD_WIDTH / 2)
-#define HALF_WORLD_HEIGHT (WORLD_HEIGHT / 2)
-
-
+#include "core/World.h"
 
 class Controller {
 
@@ -1,26 +1,38 @@
 #include "EntityManager.h"
 
-EntityManager::EntityManager(): selected_game_object_(nullptr),
-								selected_game_object_index_(-1),
+EntityManager::EntityManager(): player_pool_(player_pool),
+								mass_pool_(mass_pool),
+								spring_pool_(spring_pool),
+								collectable_pool_(collectable_pool),
 								game_controller_(nullptr),
 								gui_manager_(nullptr),
 								fluid_manager_(nullptr),
 								audio_manager_(nullptr),
 								gamemode_manager_(nullptr),
+								step_input_(nullptr),
 								cam_(nullptr),
-								new_node_type_id_(2)
+								job_system_(nullptr),
+								new_node_type_id_(2),
+								compute_time_(0),
+								spring_time_(0),
+								time_springs_(false)
 {	
+	vec_.reserve(256);
 }
 
-void EntityManager::init(Controller* game_controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager)
+void EntityManager::init(Controller* game_controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager, const StepInput* step_input, JobSystem* job_system)
 {
 	game_controller_ = game_controller;
 	gui_manager_ = gui_manager;
 	fluid_manager_ = fluid_manager;
 	audio_manager_ = audio_manager;
 	gamemode_manager_ = gamemode_manager;
+	step_input_ = step_input;
 
 	cam_ = cam;
+	job_system_ = job_system;
+
+	batch_renderer_.setup();
 }
 
 vector<GameObject*>* EntityManager::get_game_objects() const
@@ -30,7 +42,20 @@ vector<GameObject*>* EntityManager::get_game_objects() const
 
 GameObject* EntityManager::get_selected_game_object() const
 {
-	return selected_game_object_;
+	return resolve(selected_game_object_);
+}
+
+GameObject* EntityManager::resolve(const PoolHandle handle) const
+{
+	// stale handles (object already released) resolve to nullptr
+	switch (handle.pool)
+	{
+	case player_pool:		return player_pool_.get(handle);
+	case mass_pool:			return mass_pool_.get(handle);
+	case spring_pool:		return spring_pool_.get(handle);
+	case collectable_pool:	return collectable_pool_.get(handle);
+	default:				return nullptr;
+	}
 }
 
 void EntityManager::add_game_object(GameObject* _gameobject) const
@@ -43,47 +68,115 @@ void EntityManager::update()
 	delete_game_objects();
 	find_selected();
 
-	// update all gameobjects
-	for (auto& i : *get_game_objects())
+	vector<GameObject*>& objects = *get_game_objects();
+
+	// compute phase - collision and pull searches against the positions from the start of the step, each object only writes its own buffers
+	// the result doesn't depend on how the range is split, so it's the same with any number of workers
+	const auto compute = [&objects](const int begin, const int end) {
+		for (int i = begin; i < end; i++)
+		{
+			objects[i]->root_compute_interactions();
+		}
+	};
+	const uint64_t compute_start = ofGetElapsedTimeMicros();
+	{
+		PROFILE_SCOPE("compute phase");
+		if (job_system_ != nullptr)
+		{
+			job_system_->parallel_for(static_cast<int>(objects.size()), ENTITY_COMPUTE_GRAIN, compute);
+		}
+		else
+		{
+			compute(0, static_cast<int>(objects.size()));
+		}
+	}
+	compute_time_ = (ofGetElapsedTimeMicros() - compute_start) / 1000.0f;
+
+	// commit phase - applies the buffers and runs every update in list order, this is where the fluid, audio and gui are touched
+	PROFILE_SCOPE("commit phase");
+	if (!time_springs_ && !Profiler::is_enabled())
+	{
+		for (auto& i : objects)
+		{
+			i->root_update();
+		}
+		spring_time_ = 0;
+		return;
+	}
+
+	uint64_t spring_time = 0;
+	for (auto& i : objects)
 	{
-		i->root_update();
+		const PoolHandle handle = i->get_handle();
+		if (handle.is_valid() && handle.pool == spring_pool)
+		{
+			const uint64_t spring_start = ofGetElapsedTimeMicros();
+			i->root_update();
+			spring_time += ofGetElapsedTimeMicros() - spring_start;
+		}
+		else
+		{
+			i->root_update();
+		}
 	}
+	spring_time_ = spring_time / 1000.0f;
 }
 
 void EntityManager::delete_game_objects()
 {
-	// erase objects that need to be deleted and free memory
-	for (int i = 0; i < get_game_objects()->size(); i++) {
-		if ((*get_game_objects())[i]->get_type() == "Player") {
-			set_player_position(ofVec2f((*get_game_objects())[i]->get_position().x + HALF_WORLD_WIDTH, (*get_game_objects())[i]->get_position().y + HALF_WORLD_HEIGHT));
-			player_ = (*get_game_objects())[i];
+	// release objects that requested deletion in a single pass, compacting the survivors in place
+	// (the relative order is kept - collectables emit towards the next collectable in the list, and scenes are saved in this order)
+	vector<GameObject*>& objects = *get_game_objects();
+	size_t write_index = 0;
+	int deleted_count = 0;
+	for (size_t read_index = 0; read_index < objects.size(); read_index++)
+	{
+		GameObject* object = objects[read_index];
+		if (object->get_type() == "Player") {
+			set_player_position(ofVec2f(object->get_position().x + world::HALF_WORLD_WIDTH, object->get_position().y + world::HALF_WORLD_HEIGHT));
+			player_ = object->get_handle();
 		}
-		if ((*get_game_objects())[i]->get_request_to_be_deleted() == true) {
-			if ((*get_game_objects())[i] == get_selected_game_object()) {
-				selected_game_object_ = nullptr;
-			}
-			if ((*get_game_objects())[i]->get_type() == "Collectable") {
-				if ((*get_game_objects())[i]->get_request_to_be_deleted_event() == "User")
+		if (object->get_request_to_be_deleted() == true) {
+			if (object->get_type() == "Collectable") {
+				if (object->get_request_to_be_deleted_event() == "User")
 				{
 					// if an 'active' collectable is deleted, remove it from the point counter and max point count
-					if ((*get_game_objects())[i]->get_attribute_by_name("is_active") == true) {
+					if (object->get_attribute_by_name("is_active") == true) {
 						Collectable::set_points_collected(Collectable::get_points_collected() - 1);
 					}
 					gui_manager_->set_max_point_count(gui_manager_->get_max_point_count() - 1);
 				}
 			}
-			delete (*get_game_objects())[i];
-			get_game_objects()->erase(get_game_objects()->begin() + i);
+			// any handle still pointing at this object (selection, player) now resolves to nullptr
+			release(object);
+			deleted_count++;
+			continue;
 		}
+		objects[write_index++] = object;
 	}
+	objects.resize(write_index);
+	if (deleted_count > 0) FlightRecorder::mark("deleted " + ofToString(deleted_count) + " entities");
 
 	// delete all if gui requests it
-	if (gui_manager_->get_delete_all()) {
-		gui_manager_->toggle_delete_all();
+	if (gui_manager_->get_request_delete_all()) {
+		gui_manager_->set_request_delete_all(false);
 		delete_all(true);
 	}
 }
 
+void EntityManager::release(GameObject* object)
+{
+	const PoolHandle handle = object->get_handle();
+	switch (handle.pool)
+	{
+	case player_pool:		player_pool_.release(handle); break;
+	case mass_pool:			mass_pool_.release(handle); break;
+	case spring_pool:		spring_pool_.release(handle); break;
+	case collectable_pool:	collectable_pool_.release(handle); break;
+	default:				break;
+	}
+}
+
 void EntityManager::find_selected()
 {
 	// find gameobject/gameobjects that are selected
@@ -92,16 +185,15 @@ void EntityManager::find_selected()
 		if ((*get_game_objects())[i]->get_request_to_be_selected() == true)
 		{
 			
-			if (selected_game_object_ != (*get_game_objects())[i])
+			if (get_selected_game_object() != (*get_game_objects())[i])
 			{
 				// accept request
 
 				// remove previously selected object
-				if (selected_game_object_ != nullptr) (*get_game_objects())[selected_game_object_index_]->set_is_selected(false);
+				if (GameObject* previous = get_selected_game_object()) previous->set_is_selected(false);
 
 				// make new object selected
-				selected_game_object_ = (*get_game_objects())[i];
-				selected_game_object_index_ = i;
+				selected_game_object_ = (*get_game_objects())[i]->get_handle();
 				(*get_game_objects())[i]->set_is_selected(true);
 			}
 			else
@@ -115,27 +207,30 @@ void EntityManager::find_selected()
 		else if ((*get_game_objects())[i]->get_request_to_be_deselected() == true)
 		{
 			// accept request
-			selected_game_object_ = nullptr;
-			selected_game_object_index_ = -1;
+			selected_game_object_ = PoolHandle();
 			(*get_game_objects())[i]->set_is_selected(false);
 			(*get_game_objects())[i]->set_request_to_be_deselected(false);
 		}
 	}
 }
 
-void EntityManager::delete_all(const bool exclude_player) const
+void EntityManager::delete_all(const bool exclude_player)
 {
-	for (auto& i : *get_game_objects())
+	// everything goes at once, so whole pools are cleared rather than each object being flagged and released on its own
+	vector<GameObject*>& objects = *get_game_objects();
+	const size_t count = objects.size();
+	objects.erase(remove_if(objects.begin(), objects.end(), [exclude_player](const GameObject* object)
 	{
-		if (exclude_player) {
-			if (i->get_type() != "Player") {
-				i->set_request_to_be_deleted(true);
-			}
-		}
-		else {
-			i->set_request_to_be_deleted(true);
-		}
-	}
+		return !exclude_player || object->get_handle().pool != player_pool;
+	}), objects.end());
+
+	// any handle still pointing at a cleared object (selection, player) now resolves to nullptr
+	mass_pool_.clear();
+	spring_pool_.clear();
+	collectable_pool_.clear();
+	if (!exclude_player) player_pool_.clear();
+
+	FlightRecorder::mark("deleted " + ofToString(count - objects.size()) + " entities");
 }
 
 void EntityManager::set_new_node_type(int id)
@@ -148,21 +243,33 @@ int EntityManager::get_new_node_type() const
 	return new_node_type_id_;
 }
 
-void EntityManager::draw_game_objects() const
+void EntityManager::record_game_objects(BatchList& list, const ofRectangle& visible_rect, const float world_units_per_pixel)
 {
-	ofEnableAlphaBlending();
-
+	// entities submit their shapes to the list on the simulation thread, the render thread draws it later in a couple of calls
+	batch_renderer_.begin(list, world_units_per_pixel);
 	if (gui_manager_->gui_world_calculate_entities)
 	{
+		// only entities overlapping the camera view are recorded (entities are centred on the world, the view rect isn't)
+		ofRectangle view = visible_rect;
+		view.x -= world::HALF_WORLD_WIDTH;
+		view.y -= world::HALF_WORLD_HEIGHT;
+
 		for (auto& i : *get_game_objects())
 		{
-			i->root_draw();
+			if (i->is_within(view)) i->root_draw();
 		}
 	}
+	batch_renderer_.end();
+}
+
+void EntityManager::draw_game_objects(const BatchList& list)
+{
+	ofEnableAlphaBlending();
+	batch_renderer_.draw(list);
 }
 
 
-void EntityManager::create_entity() const
+void EntityManager::create_entity()
 {
 	// if no args, get new node type	
 	const int type_id = get_new_node_type();
@@ -180,34 +287,35 @@ void EntityManager::create_entity() const
 	}
 }
 
-void EntityManager::create_entity(const string entity_type) const
+void EntityManager::create_entity(const string entity_type)
 {
 	// if no pos, create at mouse pos	
 	create_entity(entity_type, ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y));
 }
 
-void EntityManager::create_entity(const string entity_type, const ofVec2f pos) const
+void EntityManager::create_entity(const string entity_type, const ofVec2f pos)
 {	
+	// drawn one statement at a time - argument evaluation order isn't fixed, and the same seed should give the same scene everywhere
+	RandomStream& random = Random::get(RANDOM_ENTITIES);
+
 	if (entity_type == "Player") {
-		GameObject* player = new Player;
-		player->init(get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
-		add_game_object(player);
+		spawn<Player>();
 	}
 	if (entity_type == "Mass") {
-		GameObject* object = new Mass(pos, ofRandom(MASS_LOWER_BOUND, MASS_UPPER_BOUND), ofRandom(RADIUS_LOWER_BOUND, RADIUS_UPPER_BOUND));
-		object->init(get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
-		add_game_object(object);
+		const float mass = random.range(world::MASS_LOWER_BOUND, world::MASS_UPPER_BOUND);
+		const float radius = random.range(world::RADIUS_LOWER_BOUND, world::RADIUS_UPPER_BOUND);
+		spawn<Mass>(pos, mass, radius);
 	}
 	else if (entity_type == "Spring") {
-		GameObject* spring = new Spring(pos, { ofRandom(25, 50), ofRandom(25, 50) }, { ofRandom(25, 75), ofRandom(25, 75) }, 2, 2, 22);
-		spring->init(get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
-		add_game_object(spring);
+		vector<float> node_radiuses(2);
+		vector<float> node_masses(2);
+		for (float& node_radius : node_radiuses) node_radius = random.range(25, 50);
+		for (float& node_mass : node_masses) node_mass = random.range(25, 75);
+		spawn<Spring>(pos, node_radiuses, node_masses, 2, 2, 22);
 	}
 	else if (entity_type == "Collectable") {
 		// if collectable is created by player (e.g. sandbox mode) activate it by default
-		GameObject* point = new Collectable(pos, 15, 25, static_cast<int>(ofRandom(75, 100)), gui_manager_->gui_world_point_force, (gamemode_manager_->get_current_mode_string() == "Sandbox") ? gui_manager_->gui_world_enable_points_upon_creation : false);
-		point->init(get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
-		add_game_object(point);
+		spawn<Collectable>(pos, 15, 25, static_cast<int>(random.range(75, 100)), gui_manager_->gui_world_point_force, (gamemode_manager_->get_current_mode_string() == "Sandbox") ? gui_manager_->gui_world_enable_points_upon_creation : false);
 		gui_manager_->set_max_point_count(gui_manager_->get_max_point_count() + 1);
 	}
 }
@@ -228,7 +336,7 @@ int EntityManager::get_point_count() const
 
 GameObject* EntityManager::get_player() const
 {
-	return player_;
+	return resolve(player_);
 }
 
 ofVec2f EntityManager::get_player_position() const
@@ -303,10 +411,10 @@ void EntityManager::mouse_pressed(const int x, const int y, const int button)
 {
 	if (button == 2)
 	{
-		if (selected_game_object_ != nullptr)
+		if (GameObject* selected = get_selected_game_object())
 		{
-			get_selected_game_object()->set_is_selected(false);
-			selected_game_object_ = nullptr;
+			selected->set_is_selected(false);
+			selected_game_object_ = PoolHandle();
 		}
 	}
 	for (auto& i : *get_game_objects())
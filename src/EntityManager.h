@@ -6,6 +6,7 @@
 #include "FluidManager.h"
 #include "AudioManager.h"
 #include "GamemodeManager.h"
+#include "JobSystem.h"
 
 // Entity types
 #include "Player.h"
@@ -13,27 +14,41 @@
 #include "Spring.h"
 #include "Collectable.h"
 
+#define ENTITY_COMPUTE_GRAIN 32 // objects per job in the compute phase of the entity step
+
 class EntityManager {
 	
 public:
 	EntityManager();
 	
-	void init(Controller* game_controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager);
+	void init(Controller* game_controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager, const StepInput* step_input, JobSystem* job_system);
 	vector<GameObject*>* get_game_objects() const;
 	GameObject* get_selected_game_object() const;
 	void add_game_object(GameObject* _gameobject) const;
 
+	// constructs an entity inside its type pool, initialises it and appends it to the scene
+	template <typename T, typename... Args>
+	T* spawn(Args&&... args);
+	GameObject* resolve(PoolHandle handle) const;
+
 	void update();
-	void draw_game_objects() const;
 
-	void delete_all(bool exclude_player = true) const;
+	// last step, ms - the compute phase is the collision/pull search, springs is their share of the commit phase
+	float get_compute_time() const	{ return compute_time_; }
+	float get_spring_time() const	{ return spring_time_; }
+	// springs are only timed while this is set or the profiler is on, otherwise get_spring_time is 0
+	void set_time_springs(const bool time_springs)	{ time_springs_ = time_springs; }
+	void record_game_objects(BatchList& list, const ofRectangle& visible_rect, float world_units_per_pixel);
+	void draw_game_objects(const BatchList& list);
+
+	void delete_all(bool exclude_player = true);
 
 	void set_new_node_type(int id);
 	int get_new_node_type() const;
 
-	void create_entity() const;
-	void create_entity(string entity_type) const;
-	void create_entity(string entity_type, ofVec2f pos) const;
+	void create_entity();
+	void create_entity(string entity_type);
+	void create_entity(string entity_type, ofVec2f pos);
 
 	int get_point_count() const;
 	GameObject* get_player() const;
@@ -51,10 +66,22 @@ public:
 private:
 
 	void delete_game_objects();
+	void release(GameObject* object);
 	
 	void find_selected();
-	GameObject* selected_game_object_;
-	int selected_game_object_index_;
+	PoolHandle selected_game_object_;
+
+	// per-type storage - objects never move once created, and freed slots are reused by the next spawn of that type
+	enum Entity_pools_ { player_pool, mass_pool, spring_pool, collectable_pool };
+	ObjectPool<Player> player_pool_;
+	ObjectPool<Mass> mass_pool_;
+	ObjectPool<Spring> spring_pool_;
+	ObjectPool<Collectable> collectable_pool_;
+
+	ObjectPool<Player>& get_pool(const Player*)				{ return player_pool_; }
+	ObjectPool<Mass>& get_pool(const Mass*)					{ return mass_pool_; }
+	ObjectPool<Spring>& get_pool(const Spring*)				{ return spring_pool_; }
+	ObjectPool<Collectable>& get_pool(const Collectable*)	{ return collectable_pool_; }
 
 	vector<GameObject*> vec_;
 	vector<GameObject*>* game_objects_ = &vec_; // the main vector of all objects in the scene
@@ -64,12 +91,33 @@ private:
 	FluidManager* fluid_manager_;
 	AudioManager* audio_manager_;
 	GamemodeManager* gamemode_manager_;
+	const StepInput* step_input_;
 	Camera* cam_;
+	JobSystem* job_system_;
 
-	GameObject* player_{ nullptr };
+	BatchRenderer batch_renderer_;
+
+	PoolHandle player_;
 	ofVec2f player_position_;
 
 	int new_node_type_id_;
 
+	float compute_time_;
+	float spring_time_;
+	bool time_springs_;
+
+
+};
+
+template <typename T, typename... Args>
+T* EntityManager::spawn(Args&&... args)
+{
+	ObjectPool<T>& pool = get_pool(static_cast<const T*>(nullptr));
+	const PoolHandle handle = pool.create(std::forward<Args>(args)...);
 
-};
\ No newline at end of file
+	T* object = pool.get(handle);
+	object->set_handle(handle);
+	object->init(get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_, step_input_, &batch_renderer_);
+	add_game_object(object);
+	return object;
+}
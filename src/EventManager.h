@@ -26,8 +26,6 @@ private:
 	vector<string> dialogues_;
 	vector<ofVec2f> positions_;
 	int current_index_;
-	ofTrueTypeFont potta_one_main_;
-	ofTrueTypeFont potta_one_context_;
 	
 	bool can_lmb_;
 	bool can_select_;
@@ -0,0 +1,116 @@
+#include "FlightRecorder.h"
+
+atomic<bool> FlightRecorder::enabled_(false);
+mutex FlightRecorder::events_mutex_;
+string FlightRecorder::pending_events_;
+
+FlightRecorder::FlightRecorder()
+	:	frames_(FLIGHT_RECORDER_FRAMES)
+	,	next_(0)
+	,	count_(0)
+	,	frames_seen_(0)
+	,	cooldown_(0)
+	,	dump_count_(0)
+{
+}
+
+void FlightRecorder::record(const FrameRecord& record, const float threshold_ms)
+{
+	// copy assigning into the ring keeps the slot's string capacity, so recording doesn't allocate once the buffer has gone round
+	FrameRecord& slot = frames_[next_];
+	slot = record;
+	{
+		lock_guard<mutex> lock(events_mutex_);
+		slot.events = pending_events_;
+		pending_events_.clear();
+	}
+
+	next_ = (next_ + 1) % FLIGHT_RECORDER_FRAMES;
+	count_ = min(count_ + 1, FLIGHT_RECORDER_FRAMES);
+	frames_seen_++;
+
+	if (cooldown_ > 0)
+	{
+		cooldown_--;
+		return;
+	}
+
+	if (frames_seen_ > FLIGHT_RECORDER_WARMUP && slot.frame_ms > threshold_ms)
+	{
+		dump(slot, threshold_ms);
+		cooldown_ = FLIGHT_RECORDER_COOLDOWN;
+	}
+}
+
+void FlightRecorder::mark(const string& event)
+{
+	if (!enabled_) return;
+
+	lock_guard<mutex> lock(events_mutex_);
+	if (!pending_events_.empty()) pending_events_ += "; ";
+	pending_events_ += event;
+}
+
+void FlightRecorder::dump(const FrameRecord& trigger, const float threshold_ms)
+{
+	// the subsystem that took the longest, as a first guess at the cause
+	const pair<const char*, float> subsystems[] = {
+		{ "update", trigger.update_ms },
+		{ "wait for simulation", trigger.wait_ms },
+		{ "draw", trigger.draw_ms },
+		{ "entities", trigger.entities_ms },
+		{ "fluid", trigger.fluid_ms },
+		{ "particles", trigger.particles_ms },
+	};
+	const auto slowest = max_element(begin(subsystems), end(subsystems), [](const pair<const char*, float>& a, const pair<const char*, float>& b) { return a.second < b.second; });
+
+	ofJson json;
+	json["date"] = ofGetTimestampString("%Y-%m-%d %H:%M:%S");
+	json["threshold_ms"] = threshold_ms;
+	json["slowest"] = slowest->first;
+	json["trigger"] = to_json(trigger);
+
+	// oldest first
+	ofJson frames = ofJson::array();
+	for (int i = 0; i < count_; i++)
+	{
+		frames.push_back(to_json(frames_[(next_ - count_ + i + FLIGHT_RECORDER_FRAMES) % FLIGHT_RECORDER_FRAMES]));
+	}
+	json["frames"] = frames;
+
+	const string path = "FlightRecorder/spike_" + ofGetTimestampString("%Y%m%d_%H%M%S") + "_" + ofToString(trigger.frame) + ".json";
+	ofDirectory::createDirectory("FlightRecorder", true, true);
+	const bool saved = ofSavePrettyJson(path, json);
+	dump_count_++;
+
+	cout << "------------FlightRecorder.cpp------------" << endl;
+	cout << " [ Frame Spike ]" << endl;
+	cout << " - Frame " << trigger.frame << ": " << ofToString(trigger.frame_ms, 1) << "ms (threshold " << ofToString(threshold_ms, 1) << "ms), slowest: " << slowest->first << endl;
+	if (!trigger.events.empty()) cout << " - Events: " << trigger.events << endl;
+	cout << ((saved) ? " - Saved to " : "Error: Couldn't save to ") << ofToDataPath(path) << endl;
+	cout << "------------------------------------------" << endl;
+
+	// shows up against the next frame, so the dump's own cost isn't mistaken for something else
+	mark("flight recorder dump");
+}
+
+ofJson FlightRecorder::to_json(const FrameRecord& record)
+{
+	ofJson json;
+	json["frame"] = record.frame;
+	json["time"] = record.time;
+	json["frame_ms"] = record.frame_ms;
+	json["update_ms"] = record.update_ms;
+	json["wait_ms"] = record.wait_ms;
+	json["draw_ms"] = record.draw_ms;
+	json["simulation_ms"] = record.simulation_ms;
+	json["entities_ms"] = record.entities_ms;
+	json["collisions_ms"] = record.collisions_ms;
+	json["springs_ms"] = record.springs_ms;
+	json["fluid_ms"] = record.fluid_ms;
+	json["particles_ms"] = record.particles_ms;
+	json["entity_count"] = record.entity_count;
+	json["particle_count"] = record.particle_count;
+	json["events"] = record.events;
+	return json;
+}
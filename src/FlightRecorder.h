@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "ofMain.h"
+
+#define FLIGHT_RECORDER_FRAMES		300		// frames kept, ~5 seconds at 60fps
+#define FLIGHT_RECORDER_WARMUP		60		// frames ignored after startup, while everything is still loading
+#define FLIGHT_RECORDER_COOLDOWN	120		// frames after a dump before another spike can trigger one (writing the dump is itself a hitch)
+
+// one frame as the flight recorder saw it, times in ms
+struct FrameRecord {
+	uint64_t frame = 0;
+	float time = 0;				// seconds since the app started
+	float frame_ms = 0;
+	float update_ms = 0;
+	float wait_ms = 0;			// update waiting for the previous simulation step
+	float draw_ms = 0;			// cpu side only, the swap is part of frame_ms
+	float simulation_ms = 0;
+	float entities_ms = 0;
+	float collisions_ms = 0;
+	float springs_ms = 0;
+	float fluid_ms = 0;
+	float particles_ms = 0;
+	int entity_count = 0;
+	int particle_count = 0;
+	string events;				// what was marked during the frame, "; " separated
+};
+
+// always on record of the last few seconds of frames - when a frame runs longer than the threshold, the whole buffer is dumped to json
+// together with the frame that triggered it, so a hitch can be looked at after the fact
+class FlightRecorder {
+
+public:
+
+	FlightRecorder();
+
+	// main thread, once per frame
+	void record(const FrameRecord& record, float threshold_ms);
+
+	// only the windowed app records frames, everywhere else (headless, benchmark, batch eval) marks are dropped rather than piling up
+	static void set_enabled(bool enabled)		{ enabled_ = enabled; }
+
+	// notable work (scene loads, explosions, mass deletions, saves) - any thread, attributed to the frame being recorded
+	static void mark(const string& event);
+
+	int get_dump_count() const					{ return dump_count_; }
+
+private:
+
+	void dump(const FrameRecord& trigger, float threshold_ms);
+	static ofJson to_json(const FrameRecord& record);
+
+	vector<FrameRecord> frames_;	// ring
+	int next_;
+	int count_;
+	int frames_seen_;
+	int cooldown_;
+	int dump_count_;
+
+	static atomic<bool> enabled_;
+	static mutex events_mutex_;
+	static string pending_events_;
+
+};
@@ -0,0 +1,161 @@
+#include "FluidImageStreamer.h"
+
+FluidImageStreamer::FluidImageStreamer()
+	:	width_(0)
+	,	height_(0)
+	,	fences_()
+	,	cur_buffer_(0)
+	,	fences_supported_(false)
+{
+}
+
+FluidImageStreamer::~FluidImageStreamer()
+{
+	for (GLsync fence : fences_)
+	{
+		if (fence != nullptr) glDeleteSync(fence);
+	}
+}
+
+bool FluidImageStreamer::supports(const msa::fluid::DrawMode mode)
+{
+	return mode == msa::fluid::kDrawColor || mode == msa::fluid::kDrawMotion || mode == msa::fluid::kDrawSpeed;
+}
+
+void FluidImageStreamer::allocate(const int width, const int height)
+{
+	width_ = width;
+	height_ = height;
+
+	// core in 3.2, a GL 2.1 context only has it through the extension
+	fences_supported_ = glewIsSupported("GL_ARB_sync");
+
+	// rgba keeps every row 4-byte aligned for the unpack
+	texture_.allocate(width_, height_, GL_RGBA8);
+	for (int i = 0; i < FLUID_STREAM_BUFFERS; i++)
+	{
+		pixel_buffers_[i].allocate(width_ * height_ * 4, GL_STREAM_DRAW);
+		if (fences_[i] != nullptr) glDeleteSync(fences_[i]);
+		fences_[i] = nullptr;
+	}
+}
+
+bool FluidImageStreamer::build(const msa::fluid::Solver& solver, const msa::fluid::DrawMode mode, const float brightness, FluidSnapshot& snapshot)
+{
+	snapshot.has_image = false;
+	if (!supports(mode) || solver.uv == nullptr || solver.color == nullptr) return false;
+
+	// same cells as the drawer - the solver's boundary ring is skipped
+	const int fluid_width = solver.getWidth();
+	const int fluid_height = solver.getHeight();
+	const int width = fluid_width - 2;
+	const int height = fluid_height - 2;
+	if (width <= 0 || height <= 0) return false;
+
+	const int origin = solver.getIndexForCell(1, 1);
+	const int stride = solver.getIndexForCell(1, 2) - origin;
+
+	snapshot.width = width;
+	snapshot.height = height;
+	snapshot.pixels.resize(width * height * 4);
+	unsigned char* pixels = snapshot.pixels.data();
+
+	const float scale = 255.0f * brightness;
+	for (int j = 0; j < height; j++)
+	{
+		const int cell = origin + j * stride;
+		unsigned char* row = pixels + j * width * 4;
+
+		switch (mode)
+		{
+		case msa::fluid::kDrawColor:
+			build_color_row(reinterpret_cast<const float*>(solver.color + cell), row, width, scale);
+			break;
+		case msa::fluid::kDrawMotion:
+			build_motion_row(reinterpret_cast<const float*>(solver.uv + cell), row, width, scale * fluid_width, scale * fluid_height);
+			break;
+		default:
+			build_speed_row(reinterpret_cast<const float*>(solver.uv + cell), row, width, scale * fluid_width, scale * fluid_height);
+			break;
+		}
+	}
+
+	snapshot.has_image = true;
+	return true;
+}
+
+void FluidImageStreamer::upload(const FluidSnapshot& snapshot)
+{
+	if (!snapshot.has_image) return;
+
+	if (snapshot.width != width_ || snapshot.height != height_) allocate(snapshot.width, snapshot.height);
+
+	// write into the next buffer in the ring - its last upload was FLUID_STREAM_BUFFERS - 1 frames ago, so its fence has normally long signalled
+	ofBufferObject& buffer = pixel_buffers_[cur_buffer_];
+	GLsync& fence = fences_[cur_buffer_];
+	if (fences_supported_)
+	{
+		if (fence != nullptr)
+		{
+			// still in flight - keep last frame's image rather than have the map wait for the gpu
+			if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) return;
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+	else
+	{
+		// no fences to tell when the buffer is free, re-allocating orphans it so mapping never waits
+		buffer.allocate(width_ * height_ * 4, GL_STREAM_DRAW);
+	}
+	cur_buffer_ = (cur_buffer_ + 1) % FLUID_STREAM_BUFFERS;
+
+	unsigned char* pixels = buffer.map<unsigned char>(GL_WRITE_ONLY);
+	if (pixels == nullptr) return;
+
+	memcpy(pixels, snapshot.pixels.data(), width_ * height_ * 4);
+	buffer.unmap();
+
+	// the copy from the bound PBO is queued on the GPU, the cpu carries on straight away
+	texture_.loadData(buffer, GL_RGBA, GL_UNSIGNED_BYTE);
+	if (fences_supported_) fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void FluidImageStreamer::draw(const float x, const float y, const float w, const float h) const
+{
+	if (texture_.isAllocated()) texture_.draw(x, y, w, h);
+}
+
+void FluidImageStreamer::build_color_row(const float* color, unsigned char* out, const int count, const float scale)
+{
+	for (int i = 0; i < count; i++)
+	{
+		out[i * 4 + 0] = static_cast<unsigned char>(min(max(color[i * 3 + 0] * scale, 0.0f), 255.0f));
+		out[i * 4 + 1] = static_cast<unsigned char>(min(max(color[i * 3 + 1] * scale, 0.0f), 255.0f));
+		out[i * 4 + 2] = static_cast<unsigned char>(min(max(color[i * 3 + 2] * scale, 0.0f), 255.0f));
+		out[i * 4 + 3] = 255;
+	}
+}
+
+void FluidImageStreamer::build_motion_row(const float* uv, unsigned char* out, const int count, const float scale_x, const float scale_y)
+{
+	for (int i = 0; i < count; i++)
+	{
+		out[i * 4 + 0] = static_cast<unsigned char>(min(fabs(uv[i * 2 + 0]) * scale_x, 255.0f));
+		out[i * 4 + 1] = static_cast<unsigned char>(min(fabs(uv[i * 2 + 1]) * scale_y, 255.0f));
+		out[i * 4 + 2] = 0;
+		out[i * 4 + 3] = 255;
+	}
+}
+
+void FluidImageStreamer::build_speed_row(const float* uv, unsigned char* out, const int count, const float scale_x, const float scale_y)
+{
+	for (int i = 0; i < count; i++)
+	{
+		const unsigned char speed = static_cast<unsigned char>(min(fabs(uv[i * 2 + 0]) * scale_x + fabs(uv[i * 2 + 1]) * scale_y, 255.0f));
+		out[i * 4 + 0] = speed;
+		out[i * 4 + 1] = speed;
+		out[i * 4 + 2] = speed;
+		out[i * 4 + 3] = 255;
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ofMain.h"
+#include "MSAFluid.h"
+#include "RenderSnapshot.h"
+
+#define FLUID_STREAM_BUFFERS 3
+
+// builds the fluid visualisation image straight from the solver arrays and streams it to a texture through a ring of pixel buffer objects
+// the image is built on the simulation thread into the frame's snapshot, the render thread only uploads it
+// the upload from a PBO is asynchronous, so the GPU copy of one frame overlaps the CPU work of the next - replaces the drawer's build + synchronous glTexSubImage
+// each buffer is fenced after its upload and only written again once the fence has signalled, without ARB_sync the buffer is orphaned instead
+class FluidImageStreamer {
+
+public:
+
+	FluidImageStreamer();
+	~FluidImageStreamer();
+
+	// simulation thread - returns false for draw modes it doesn't handle (vectors), the drawer should be used for those
+	static bool build(const msa::fluid::Solver& solver, msa::fluid::DrawMode mode, float brightness, FluidSnapshot& snapshot);
+
+	// render thread
+	void upload(const FluidSnapshot& snapshot);
+	void draw(float x, float y, float w, float h) const;
+
+	static bool supports(msa::fluid::DrawMode mode);
+
+private:
+
+	void allocate(int width, int height);
+
+	// row kernels - plain loops over the solver's float arrays so the compiler can vectorise them
+	static void build_color_row(const float* color, unsigned char* out, int count, float scale);
+	static void build_motion_row(const float* uv, unsigned char* out, int count, float scale_x, float scale_y);
+	static void build_speed_row(const float* uv, unsigned char* out, int count, float scale_x, float scale_y);
+
+	int width_;
+	int height_;
+
+	ofTexture texture_;
+	ofBufferObject pixel_buffers_[FLUID_STREAM_BUFFERS];
+	GLsync fences_[FLUID_STREAM_BUFFERS];	// the last upload from each buffer, null once it's known to have finished
+	int cur_buffer_;
+	bool fences_supported_;
+
+};
@@ -1,5 +1,11 @@
 #include "FluidManager.h"
 
+// the blur target only needs a few pixels per fluid cell - the field is bilinearly upsampled anyway
+static const int BLUR_PIXELS_PER_CELL = 8;
+static const int BLUR_SIZE_STEP = 128; // target widths are bucketed so zooming doesn't rebuild the blur every frame
+static const int BLUR_MIN_WIDTH = 256;
+static const float BLUR_RADIUS = 32; // radius at full world resolution
+
 FluidManager::FluidManager(): fluid_cells_x_(150),
                               resize_fluid_(false),
                               color_mult_(0),
@@ -8,6 +14,8 @@ FluidManager::FluidManager(): fluid_cells_x_(150),
                               draw_particles_(true),
                               tuio_x_scaler_(1),
                               tuio_y_scaler_(1),
+                              blur_width_(0),
+                              blur_height_(0),
                               do_increment_brightness_(false),
                               prev_brightness_(-1),
                               do_increment_delta_t_(false),
@@ -15,22 +23,44 @@ FluidManager::FluidManager(): fluid_cells_x_(150),
                               do_increment_viscocity_(false),
                               prev_viscocity_(-1),
                               do_increment_velocity_(false),
-                              prev_velocity_(-1)
+                              prev_velocity_(-1),
+                              gui_manager_(nullptr),
+                              cam_(nullptr),
+                              headless_(false)
 
 {
 }
 
-void FluidManager::init(GUIManager* gui_manager)
+void FluidManager::init(GUIManager* gui_manager, Camera* cam, const bool headless)
 {
 	gui_manager_ = gui_manager;
+	cam_ = cam;
+	headless_ = headless;
 
 	fluid_solver_.setup(100, 100);
 	fluid_solver_.enableRGB(true).setFadeSpeed(0.002f).setDeltaT(0.5f).setVisc(0.00015f).setColorDiffusion(0);
-	fluid_drawer_.setup(&fluid_solver_);
+	if (!headless_) fluid_drawer_.setup(&fluid_solver_); // the drawer and the blur allocate GL textures/FBOs
 
 	update_from_gui();
 
-	fluid_blur_.setup(WORLD_WIDTH, WORLD_HEIGHT, 32, 0.2f, 2);
+	if (!headless_) update_blur_target();
+}
+
+void FluidManager::update_blur_target()
+{
+	// size the blur target from the fluid grid, but never above what the camera can actually show of the world
+	const float on_screen_width = world::WORLD_WIDTH / cam_->get_world_units_per_pixel();
+	int width = static_cast<int>(min(static_cast<float>(fluid_solver_.getWidth() * BLUR_PIXELS_PER_CELL), on_screen_width));
+	width = ofClamp(ceil(width / static_cast<float>(BLUR_SIZE_STEP)) * BLUR_SIZE_STEP, BLUR_MIN_WIDTH, world::WORLD_WIDTH);
+
+	if (width == blur_width_) return;
+
+	blur_width_ = width;
+	blur_height_ = width * world::WORLD_HEIGHT / world::WORLD_WIDTH;
+
+	// keep the blur the same size in world space
+	const int radius = max(1, static_cast<int>(round(BLUR_RADIUS * blur_width_ / world::WORLD_WIDTH)));
+	fluid_blur_.setup(blur_width_, blur_height_, radius, 0.2f, 2);
 }
 
 void FluidManager::update()
@@ -40,11 +70,14 @@ void FluidManager::update()
 	if (resize_fluid_)
 	{
 		fluid_solver_.setSize(fluid_cells_x_, fluid_cells_x_ / msa::getWindowAspectRatio());
-		fluid_drawer_.setup(&fluid_solver_);
+		if (!headless_) fluid_drawer_.setup(&fluid_solver_);
 		resize_fluid_ = false;
 	}
 
-	fluid_solver_.update();
+	{
+		PROFILE_SCOPE("solver");
+		fluid_solver_.update();
+	}
 
 	if (do_increment_brightness_)
 	{
@@ -107,40 +140,69 @@ void FluidManager::update_from_gui()
 	fluid_solver_.wrap_x = fluid_solver_.wrap_y = gui_manager_->gui_fluid_wrap_edges;
 }
 
-void FluidManager::draw(GameObject* player)
+void FluidManager::update_fluid_snapshot(FluidSnapshot& snapshot)
 {
-	render_fluid();
-	render_particles(player);
+	// colour/motion/speed images are built straight from the solver, the drawer only handles vectors
+	snapshot.visible = gui_manager_->gui_fluid_calculate_fluid && draw_fluid_;
+	if (snapshot.visible) FluidImageStreamer::build(fluid_solver_, fluid_drawer_.drawMode, fluid_drawer_.brightness, snapshot);
 }
 
-void FluidManager::render_fluid()
+void FluidManager::update_particle_snapshot(GameObject* player, const ofRectangle& visible_rect, const float world_units_per_pixel, ParticleSnapshot& snapshot)
 {
-	if (gui_manager_->gui_fluid_calculate_fluid)
+	snapshot.visible = false;
+	if (gui_manager_->gui_fluid_calculate_particles)
 	{
-		fluid_blur_.begin();
-		if (draw_fluid_)
+		if (draw_particles_ && player != nullptr)
 		{
-			ofBackground(0);
-			ofClear(0);
-			glColor3f(1, 1, 1);
-			fluid_drawer_.draw(0, 0, WORLD_WIDTH, WORLD_HEIGHT);
+			particle_system_.update(solver_field_, ofVec2f(world::WORLD_WIDTH, world::WORLD_HEIGHT), draw_fluid_, player, visible_rect, world_units_per_pixel, snapshot);
 		}
-		fluid_blur_.end();
-		fluid_blur_.draw(); // blur only applies to background fluid
 	}
 }
 
-void FluidManager::render_particles(GameObject* player)
+void FluidManager::draw(const RenderSnapshot& snapshot, std::mutex& simulation_mutex)
 {
-	if (gui_manager_->gui_fluid_calculate_particles)
+	render_fluid(snapshot.fluid, simulation_mutex);
+	render_particles(snapshot.particles);
+}
+
+void FluidManager::render_fluid(const FluidSnapshot& snapshot, std::mutex& simulation_mutex)
+{
+	if (snapshot.visible)
 	{
-		if (draw_particles_)
+		PROFILE_SCOPE("fluid");
+		GPU_SCOPE("fluid");
+		update_blur_target();
+
+		fluid_blur_.begin();
+		ofBackground(0);
+		ofClear(0);
+		glColor3f(1, 1, 1);
+
+		if (snapshot.has_image)
+		{
+			PROFILE_SCOPE("upload");
+			fluid_image_streamer_.upload(snapshot);
+			fluid_image_streamer_.draw(0, 0, blur_width_, blur_height_);
+		}
+		else
 		{
-			particle_system_.update_and_draw(fluid_solver_, ofVec2f(WORLD_WIDTH, WORLD_HEIGHT), draw_fluid_, player);
+			lock_guard<mutex> lock(simulation_mutex);
+			fluid_drawer_.draw(0, 0, blur_width_, blur_height_);
 		}
+		PROFILE_SCOPE("blur");
+		GPU_SCOPE("blur");
+		fluid_blur_.end();
+		fluid_blur_.draw(ofRectangle(0, 0, world::WORLD_WIDTH, world::WORLD_HEIGHT)); // blur only applies to background fluid, upsampled to the world here
 	}
 }
 
+void FluidManager::render_particles(const ParticleSnapshot& snapshot)
+{
+	PROFILE_SCOPE("particles");
+	GPU_SCOPE("particles");
+	particle_system_.draw(snapshot, ofVec2f(world::WORLD_WIDTH, world::WORLD_HEIGHT));
+}
+
 void FluidManager::add_to_fluid(ofVec2f pos, const ofVec2f vel, const bool add_color, const bool add_force, const int count)
 {
 	const float speed = vel.x * vel.x + vel.y * vel.y * msa::getWindowAspectRatio() * msa::getWindowAspectRatio();    // balance the x and y components of speed with the screen aspect ratio
@@ -159,7 +221,7 @@ void FluidManager::add_to_fluid(ofVec2f pos, const ofVec2f vel, const bool add_c
 			fluid_solver_.addColorAtIndex(index, draw_color * color_mult_);
 
 			if (draw_particles_)
-				particle_system_.add_particles(pos * ofVec2f(WORLD_WIDTH, WORLD_HEIGHT), count);
+				particle_system_.add_particles(pos * ofVec2f(world::WORLD_WIDTH, world::WORLD_HEIGHT), count);
 		}
 
 		if (add_force)
@@ -170,10 +232,19 @@ void FluidManager::add_to_fluid(ofVec2f pos, const ofVec2f vel, const bool add_c
 
 void FluidManager::explosion(const int count)
 {
+	FlightRecorder::mark("explosion " + ofToString(count));
+
+	// positions and velocities drawn in bulk, up front
+	RandomStream& random = Random::get(RANDOM_FLUID);
+	float* positions = FrameArena::allocate<float>(count * 2);
+	float* velocities = FrameArena::allocate<float>(count * 2);
+	random.fill(positions, count * 2, 0, 1);
+	random.fill(velocities, count * 2, -0.01f, 0.01f);
+
 	for (int i = 0; i < count; i++)
 	{
-		const ofVec2f pos = ofVec2f(ofRandom(0, 1), ofRandom(0, 1));
-		const ofVec2f vel = ofVec2f(ofRandom(-0.01f, 0.01f), ofRandom(-0.01f, 0.01f));
+		const ofVec2f pos = ofVec2f(positions[i * 2], positions[i * 2 + 1]);
+		const ofVec2f vel = ofVec2f(velocities[i * 2], velocities[i * 2 + 1]);
 		add_to_fluid(pos, vel, true, true);
 	}
 }
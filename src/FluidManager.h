@@ -1,11 +1,35 @@
 #pragma once
 
+#include <mutex>
+
 #include "MSAFluid.h"
 #include "ofxBlur.h"
 #include "ofxSimpleGuiToo.h"
 #include "GUIManager.h"
+#include "Camera.h"
 #include "Controller.h"
 #include "ParticleSystem.h"
+#include "FluidImageStreamer.h"
+#include "FlightRecorder.h"
+#include "core/FluidField.h"
+#include "core/FrameArena.h"
+#include "GpuTimer.h"
+#include "Profiler.h"
+
+// the simulation's view of the solver
+class SolverField : public FluidField
+{
+public:
+
+	explicit SolverField(const msa::fluid::Solver& solver) : solver_(solver) {}
+
+	Vec2 velocity_at(const Vec2 normalised_pos) const override { return Vec2(solver_.getVelocityAtPos(normalised_pos.to<ofVec2f>())); }
+
+private:
+
+	const msa::fluid::Solver& solver_;
+
+};
 
 class FluidManager
 {
@@ -13,14 +37,18 @@ public:
 
 	FluidManager();
 
-	void init(GUIManager* gui_manager);	
+	void init(GUIManager* gui_manager, Camera* cam, bool headless = false);
 
 	void update();
 	void update_from_gui();
+	void update_fluid_snapshot(FluidSnapshot& snapshot);
+	void update_particle_snapshot(GameObject* player, const ofRectangle& visible_rect, float world_units_per_pixel, ParticleSnapshot& snapshot);
 	
-	void draw(GameObject* player);
-	void render_fluid();
-	void render_particles(GameObject* player);
+	// the vectors draw mode still reads the solver directly, it's drawn under the simulation lock
+	void draw(const RenderSnapshot& snapshot, std::mutex& simulation_mutex);
+	void render_fluid(const FluidSnapshot& snapshot, std::mutex& simulation_mutex);
+	void update_blur_target();
+	void render_particles(const ParticleSnapshot& snapshot);
 
 	void add_to_fluid(ofVec2f pos, ofVec2f vel, bool add_color, bool add_force, int count = 10);
 	void explosion(int count = 500);
@@ -31,6 +59,7 @@ public:
 	void reset_fluid();
 
 	msa::fluid::Solver* get_solver();
+	const FluidField& get_field() const { return solver_field_; }
 	msa::fluid::DrawerGl* get_drawer();
 	ParticleSystem* get_particle_system();
 
@@ -48,11 +77,15 @@ private:
 	float tuio_y_scaler_;
 
 	msa::fluid::Solver fluid_solver_;
+	SolverField solver_field_{ fluid_solver_ };
 	msa::fluid::DrawerGl fluid_drawer_;
+	FluidImageStreamer fluid_image_streamer_;
 
 	ParticleSystem particle_system_;
 
 	ofxBlur fluid_blur_;
+	int blur_width_;
+	int blur_height_;
 
 	bool do_increment_brightness_;
 	float prev_brightness_;
@@ -64,5 +97,8 @@ private:
 	float prev_velocity_;
 
 	GUIManager* gui_manager_;
+	Camera* cam_;
+
+	bool headless_; // no GL context - the solver and particles still step, nothing is drawn
 	
 };
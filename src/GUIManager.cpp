@@ -13,10 +13,13 @@ GUIManager::GUIManager()
 	,	points_collected_(0)
 	,	max_point_count_(0)
 	,	request_delete_all_(false)
-	,	request_new_scene_(true)
-	,	request_save_scene_(true)
-	,	request_quickload_scene_(true)
-	,	request_load_scene_(true)
+	,	request_new_scene_(false)
+	,	request_save_scene_(false)
+	,	request_quickload_scene_(false)
+	,	request_load_scene_(false)
+	,	last_perf_update_(0)
+	,	shown_render_scale_(-1)
+	,	shown_average_frame_time_(-1)
 {
 	const string error_message = "Error: Updating failed"; // error message will show for all parameters that require but haven't received an update
 	const int error_int = 404;
@@ -25,12 +28,12 @@ GUIManager::GUIManager()
 	const ofVec2f damping_bounds = { 0.1f, 8.0f };
 	ofVec2f springmass_bounds = { 0.1f, 50.0f };
 
-	gui_world_delete_all.addListener(this, &GUIManager::toggle_delete_all);
-	gui_scene_new.addListener(this, &GUIManager::toggle_new_scene);
-	gui_scene_save.addListener(this, &GUIManager::toggle_save_scene);
-	gui_scene_quickload.addListener(this, &GUIManager::toggle_quickload_scene);
-	gui_scene_load.addListener(this, &GUIManager::toggle_load_scene);
-	gui_fluid_reset_fluid.addListener(this, &GUIManager::reset_fluid_settings);
+	gui_world_delete_all.addListener(this, &GUIManager::on_delete_all_pressed);
+	gui_scene_new.addListener(this, &GUIManager::on_new_scene_pressed);
+	gui_scene_save.addListener(this, &GUIManager::on_save_scene_pressed);
+	gui_scene_quickload.addListener(this, &GUIManager::on_quickload_scene_pressed);
+	gui_scene_load.addListener(this, &GUIManager::on_load_scene_pressed);
+	gui_fluid_reset_fluid.addListener(this, &GUIManager::on_reset_fluid_pressed);
 
 	// Scene
 	panel_scene.setup("Scene", "", panel_pixel_buffer_, panel_pixel_buffer_);
@@ -66,13 +69,21 @@ GUIManager::GUIManager()
 	panel_perf.setup("Performance", "", panel_pixel_buffer_, panel_fluid.getPosition().y + panel_fluid.getHeight() + panel_pixel_buffer_);
 	panel_perf.add(gui_perf_fps.setup("FPS", error_message));
 	panel_perf.add(gui_perf_frametime.setup("Frametime", error_message));
+	panel_perf.add(gui_perf_dynamic_resolution.setup("dynamic resolution", true));
+	panel_perf.add(gui_perf_render_scale.setup("render scale", error_message));
+	panel_perf.add(gui_perf_gpu.setup("GPU", error_message));
+	panel_perf.add(gui_perf_allocations.setup("allocations", error_message));
+	panel_perf.add(gui_perf_show_task_graph.setup("show task graph", false));
+	panel_perf.add(gui_perf_show_profiler.setup("show profiler", false));
+	panel_perf.add(gui_perf_show_allocations.setup("show allocations", false));
+	panel_perf.add(gui_perf_spike_threshold.setup("spike threshold ms", 50, 10, 250));
 	
 	// Player
 	panel_player.setup("Player", "", panel_pixel_buffer_, panel_world.getPosition().y + panel_world.getHeight() + panel_pixel_buffer_);
 	panel_player.add(gui_player_pos.setup("pos", error_message));
 	panel_player.add(gui_player_vel.setup("vel", error_message));
 	panel_player.add(gui_player_accel.setup("acceleration", error_message));
-	panel_player.add(gui_player_mass.setup("mass", error_int, MINIMUM_MASS, MAXIMUM_MASS));
+	panel_player.add(gui_player_mass.setup("mass", error_int, world::MINIMUM_MASS, world::MAXIMUM_MASS));
 	panel_player.add(gui_player_infinite_mass.setup("infinite mass", false));
 	panel_player.add(gui_player_radius.setup("radius", error_int, 8, 300));
 	
@@ -81,8 +92,8 @@ GUIManager::GUIManager()
 	panel_node.add(gui_node_pos.setup("pos", error_message));
 	panel_node.add(gui_node_vel.setup("vel", error_message));
 	panel_node.add(gui_node_accel.setup("acceleration", error_message));
-	panel_node.add(gui_node_mass.setup("mass", error_int, MINIMUM_MASS, MAXIMUM_MASS));
-	panel_node.add(gui_node_radius.setup("radius", error_int, RADIUS_MINIMUM, RADIUS_MAXIMUM));
+	panel_node.add(gui_node_mass.setup("mass", error_int, world::MINIMUM_MASS, world::MAXIMUM_MASS));
+	panel_node.add(gui_node_radius.setup("radius", error_int, world::RADIUS_MINIMUM, world::RADIUS_MAXIMUM));
 
 	// Collectable
 	panel_collectable.setup("Collectable", "", ofGetWidth() - panel_node.getWidth() - panel_pixel_buffer_, panel_pixel_buffer_);
@@ -98,7 +109,7 @@ GUIManager::GUIManager()
 	panel_spring_settings.add(gui_spring_anchor_pos.setup("anchor pos", error_message));
 	panel_spring_settings.add(gui_spring_k.setup("springiness", error_int, k_bounds.x, k_bounds.y));
 	panel_spring_settings.add(gui_spring_damping.setup("damping", error_int, damping_bounds.x, damping_bounds.y));
-	panel_spring_settings.add(gui_spring_springmass.setup("springmass", error_int, MINIMUM_MASS, MAXIMUM_MASS));
+	panel_spring_settings.add(gui_spring_springmass.setup("springmass", error_int, world::MINIMUM_MASS, world::MAXIMUM_MASS));
 	panel_spring_settings.add(gui_spring_add_node.setup("add node"));
 	
 	// Spring Node
@@ -106,15 +117,19 @@ GUIManager::GUIManager()
 	panel_spring_node.add(gui_spring_node_pos.setup("pos", error_message));
 	panel_spring_node.add(gui_spring_node_vel.setup("vel", error_message));
 	panel_spring_node.add(gui_spring_node_accel.setup("acceleration", error_message));
-	panel_spring_node.add(gui_spring_node_mass.setup("mass", error_int, MINIMUM_MASS, MAXIMUM_MASS / 10));
-	panel_spring_node.add(gui_spring_node_radius.setup("radius", error_int, RADIUS_MINIMUM, 100));
-
-
-
-	potta_one_title_.load("Fonts/PottaOne-Regular.ttf", 96, true, true);
-	potta_one_main_.load("Fonts/PottaOne-Regular.ttf", 24, true, true);
-	potta_one_sub_.load("Fonts/PottaOne-Regular.ttf", 16, true, true);
-	potta_one_mini_.load("Fonts/PottaOne-Regular.ttf", 14, true, true);
+	panel_spring_node.add(gui_spring_node_mass.setup("mass", error_int, world::MINIMUM_MASS, world::MAXIMUM_MASS / 10));
+	panel_spring_node.add(gui_spring_node_radius.setup("radius", error_int, world::RADIUS_MINIMUM, 100));
+
+
+	cached_panel_world_.setup(&panel_world);
+	cached_panel_scene_.setup(&panel_scene);
+	cached_panel_fluid_.setup(&panel_fluid);
+	cached_panel_perf_.setup(&panel_perf);
+	cached_panel_player_.setup(&panel_player);
+	cached_panel_node_.setup(&panel_node);
+	cached_panel_collectable_.setup(&panel_collectable);
+	cached_panel_spring_settings_.setup(&panel_spring_settings);
+	cached_panel_spring_node_.setup(&panel_spring_node);
 	
 	window_resized();
 }
@@ -126,6 +141,15 @@ void GUIManager::init(Controller* controller, AudioManager* audio_manager, Camer
 	cam_ = cam;
 }
 
+// needs a GL context - skipped when running headless
+void GUIManager::load_fonts(AssetManager& assets)
+{
+	title_text_.setup(assets.get_font("Fonts/PottaOne-Regular.ttf", 96));
+	main_text_.setup(assets.get_font("Fonts/PottaOne-Regular.ttf", 24));
+	sub_text_.setup(assets.get_font("Fonts/PottaOne-Regular.ttf", 16));
+	mini_text_.setup(assets.get_font("Fonts/PottaOne-Regular.ttf", 14));
+}
+
 void GUIManager::update()
 {
 	update_world();
@@ -133,8 +157,25 @@ void GUIManager::update()
 
 void GUIManager::update_world()
 {
-	gui_perf_fps = ofToString(ofGetFrameRate());
-	gui_perf_frametime = ofToString(ofGetLastFrameTime());
+	// these change every frame, so they're refreshed a few times a second rather than re-rendering the panel every frame
+	if (ofGetElapsedTimeMillis() - last_perf_update_ < 250) return;
+	last_perf_update_ = ofGetElapsedTimeMillis();
+
+	set_label(gui_perf_fps, ofToString(ofGetFrameRate(), 1));
+	set_label(gui_perf_frametime, ofToString(ofGetLastFrameTime(), 4));
+	set_label(gui_perf_gpu, (GpuTimer::is_supported()) ? ofToString(GpuTimer::get_frame_time(), 2) + "ms" : "n/a");
+	set_label(gui_perf_allocations, ofToString(AllocationTracker::get_frame_count()) + " (" + ofToString(AllocationTracker::get_frame_bytes() / 1024.0f, 1) + "kb)");
+}
+
+void GUIManager::update_render_scale_values(const float render_scale, const float average_frame_time)
+{
+	const float shown_scale = round(render_scale * 100);
+	const float shown_frame_time = round(average_frame_time * 10) / 10;
+	if (shown_scale == shown_render_scale_ && shown_frame_time == shown_average_frame_time_) return;
+
+	shown_render_scale_ = shown_scale;
+	shown_average_frame_time_ = shown_frame_time;
+	set_label(gui_perf_render_scale, ofToString(static_cast<int>(shown_scale)) + "% (" + ofToString(shown_frame_time, 1) + "ms avg)");
 }
 
 
@@ -165,34 +206,34 @@ void GUIManager::reset_point_counters()
 	points_collected_ = 0;
 }
 
-int GUIManager::get_delete_all() const
+void GUIManager::queue_command(const GuiCommand command)
 {
-	return request_delete_all_;
+	lock_guard<mutex> lock(commands_mutex_);
+	pending_commands_.push_back(command);
 }
 
-bool GUIManager::get_request_new_scene() const
+void GUIManager::apply_commands()
 {
-	return request_new_scene_;
-}
-
-bool GUIManager::get_request_save_scene() const
-{
-	return request_save_scene_;
-}
-
-bool GUIManager::get_request_quickload_scene() const
-{
-	return request_quickload_scene_;
-}
-
-bool GUIManager::get_request_load_scene() const
-{
-	return request_load_scene_;
-}
+	{
+		lock_guard<mutex> lock(commands_mutex_);
+		if (pending_commands_.empty()) return;
+		applied_commands_.swap(pending_commands_);
+	}
 
-void GUIManager::toggle_delete_all()
-{
-	(request_delete_all_ == 0) ? request_delete_all_ = true : request_delete_all_ = false;
+	// a press sets its request once, whichever thread consumes it clears it
+	for (const GuiCommand command : applied_commands_)
+	{
+		switch (command)
+		{
+		case GUI_COMMAND_DELETE_ALL:		request_delete_all_ = true; break;
+		case GUI_COMMAND_NEW_SCENE:			request_new_scene_ = true; reset_fluid_settings(); break;
+		case GUI_COMMAND_SAVE_SCENE:		request_save_scene_ = true; break;
+		case GUI_COMMAND_QUICKLOAD_SCENE:	request_quickload_scene_ = true; break;
+		case GUI_COMMAND_LOAD_SCENE:		request_load_scene_ = true; break;
+		case GUI_COMMAND_RESET_FLUID:		reset_fluid_settings(); break;
+		}
+	}
+	applied_commands_.clear();
 }
 
 void GUIManager::reset_fluid_settings()
@@ -206,27 +247,6 @@ void GUIManager::reset_fluid_settings()
 	gui_fluid_wrap_edges = false;
 }
 
-void GUIManager::toggle_new_scene()
-{
-	(request_new_scene_ == 0) ? request_new_scene_ = true : request_new_scene_ = false;
-	reset_fluid_settings();
-}
-
-void GUIManager::toggle_save_scene()
-{
-	(request_save_scene_ == 0) ? request_save_scene_ = true : request_save_scene_ = false;
-}
-
-void GUIManager::toggle_quickload_scene()
-{
-	(request_quickload_scene_ == 0) ? request_quickload_scene_ = true : request_quickload_scene_ = false;
-}
-
-void GUIManager::toggle_load_scene()
-{
-	(request_load_scene_ == 0) ? request_load_scene_ = true : request_load_scene_ = false;
-}
-
 void GUIManager::set_gui_visible(const bool value)
 {
 	(value == 1) ? gui_visible_ = true : gui_visible_ = false;
@@ -239,88 +259,124 @@ bool GUIManager::get_gui_visible() const
 
 
 
-void GUIManager::update_player_values(const ofVec2f pos, const ofVec2f vel, const ofVec2f accel, const float mass, const bool infmass, const float radius)
+void GUIManager::update_player_values(const Vec2 pos, const Vec2 vel, const Vec2 accel, const float mass, const bool infmass, const float radius)
 {
-	panel_player.setName("Player");
-	panel_player.setPosition(cam_->world_to_screen(ofVec2f(HALF_WORLD_WIDTH + pos.x + 8, HALF_WORLD_HEIGHT + pos.y + 8)));
+	set_panel_name(panel_player, cached_panel_player_, "Player");
+	panel_player.setPosition(cam_->world_to_screen(ofVec2f(world::HALF_WORLD_WIDTH + pos.x + 8, world::HALF_WORLD_HEIGHT + pos.y + 8)));
 	
-	gui_player_pos = ofToString(roundf(pos.x)) + ", " + ofToString(roundf(pos.y));
-	gui_player_vel = ofToString(roundf(vel.x * 100) / 100) + ", " + ofToString(roundf(vel.y * 100) / 100);
-	gui_player_accel = ofToString(roundf(accel.x * 10000) / 10000) + ", " + ofToString(roundf(accel.y * 10000) / 10000);
+	set_vec_label(gui_player_pos, pos, 1);
+	set_vec_label(gui_player_vel, vel, 100);
+	set_vec_label(gui_player_accel, accel, 10000);
 	if (infmass)
 	{
 		gui_player_mass.setTextColor(0);
-		gui_player_infinite_mass = true;
+		set_toggle(gui_player_infinite_mass, true);
 	}
 	else
 	{
 		gui_player_mass.setTextColor(255);
-		gui_player_mass = mass;
-		gui_player_infinite_mass = false;
+		set_slider(gui_player_mass, mass);
+		set_toggle(gui_player_infinite_mass, false);
 	}
-	gui_player_radius = radius;
+	set_slider(gui_player_radius, radius);
 }
 
-void GUIManager::update_mass_values(const ofVec2f pos, const ofVec2f vel, const ofVec2f accel, const float mass, const float radius)
+void GUIManager::update_mass_values(const Vec2 pos, const Vec2 vel, const Vec2 accel, const float mass, const float radius)
 {
-	panel_node.setName("Mass");
-	panel_node.setPosition(cam_->world_to_screen(ofVec2f(HALF_WORLD_WIDTH + pos.x + 8, HALF_WORLD_HEIGHT + pos.y + 8)));
+	set_panel_name(panel_node, cached_panel_node_, "Mass");
+	panel_node.setPosition(cam_->world_to_screen(ofVec2f(world::HALF_WORLD_WIDTH + pos.x + 8, world::HALF_WORLD_HEIGHT + pos.y + 8)));
 
-	gui_node_pos = ofToString(roundf(pos.x)) + ", " + ofToString(roundf(pos.y));
-	gui_node_vel = ofToString(roundf(vel.x * 100) / 100) + ", " + ofToString(roundf(vel.y * 100) / 100);
-	gui_node_accel = ofToString(roundf(accel.x * 10000) / 10000) + ", " + ofToString(roundf(accel.y * 10000) / 10000);
-	gui_node_mass = mass;
-	gui_node_radius = radius;
+	set_vec_label(gui_node_pos, pos, 1);
+	set_vec_label(gui_node_vel, vel, 100);
+	set_vec_label(gui_node_accel, accel, 10000);
+	set_slider(gui_node_mass, mass);
+	set_slider(gui_node_radius, radius);
 }
 
-void GUIManager::update_collectable_values(const ofVec2f pos, const ofVec2f vel, const ofVec2f accel, const float radius, const float emission_frequency, const float emission_force, const bool is_active, const int id)
+void GUIManager::update_collectable_values(const Vec2 pos, const Vec2 vel, const Vec2 accel, const float radius, const float emission_frequency, const float emission_force, const bool is_active, const int id)
 {
-	panel_collectable.setName("Collectable");
-	panel_collectable.setPosition(cam_->world_to_screen(ofVec2f(HALF_WORLD_WIDTH + pos.x + 8, HALF_WORLD_HEIGHT + pos.y + 8)));
+	set_panel_name(panel_collectable, cached_panel_collectable_, "Collectable");
+	panel_collectable.setPosition(cam_->world_to_screen(ofVec2f(world::HALF_WORLD_WIDTH + pos.x + 8, world::HALF_WORLD_HEIGHT + pos.y + 8)));
 
-	gui_collectable_pos = ofToString(roundf(pos.x)) + ", " + ofToString(roundf(pos.y));
-	gui_collectable_radius = radius;
-	gui_collectable_emission_frequency = emission_frequency;
-	gui_collectable_emission_force = emission_force;
-	gui_collectable_is_active = is_active;
-	gui_collectable_id = id;
+	set_vec_label(gui_collectable_pos, pos, 1);
+	set_slider(gui_collectable_radius, radius);
+	set_slider(gui_collectable_emission_frequency, emission_frequency);
+	set_slider(gui_collectable_emission_force, emission_force);
+	set_toggle(gui_collectable_is_active, is_active);
+	if (gui_collectable_id != id) gui_collectable_id = id;
 }
 
 
 
-void GUIManager::update_spring_values(const ofVec2f anchor_position, const float k, const float damping, const float springmass, const ofVec2f selected_node_pos, const ofVec2f selected_node_vel, const ofVec2f selected_node_accel, const float selected_node_mass, const float selected_node_radius)
+void GUIManager::update_spring_values(const Vec2 anchor_position, const float k, const float damping, const float springmass, const Vec2 selected_node_pos, const Vec2 selected_node_vel, const Vec2 selected_node_accel, const float selected_node_mass, const float selected_node_radius)
 {
-	panel_spring_settings.setPosition(cam_->world_to_screen(ofVec2f(HALF_WORLD_WIDTH + anchor_position.x + 8, HALF_WORLD_HEIGHT + anchor_position.y + 8)));
-	panel_spring_node.setPosition(cam_->world_to_screen(ofVec2f(HALF_WORLD_WIDTH + selected_node_pos.x + 8, HALF_WORLD_HEIGHT + selected_node_pos.y + 8)));
+	panel_spring_settings.setPosition(cam_->world_to_screen(ofVec2f(world::HALF_WORLD_WIDTH + anchor_position.x + 8, world::HALF_WORLD_HEIGHT + anchor_position.y + 8)));
+	panel_spring_node.setPosition(cam_->world_to_screen(ofVec2f(world::HALF_WORLD_WIDTH + selected_node_pos.x + 8, world::HALF_WORLD_HEIGHT + selected_node_pos.y + 8)));
 	
-	gui_spring_anchor_pos = ofToString(roundf(anchor_position.x)) + ", " + ofToString(roundf(anchor_position.y));
+	set_vec_label(gui_spring_anchor_pos, anchor_position, 1);
 
-	gui_spring_k = k;
-	gui_spring_damping = damping;
-	gui_spring_springmass = springmass;
+	set_slider(gui_spring_k, k);
+	set_slider(gui_spring_damping, damping);
+	set_slider(gui_spring_springmass, springmass);
 	
-	gui_spring_node_pos = ofToString(roundf(selected_node_pos.x)) + ", " + ofToString(roundf(selected_node_pos.y));
-	gui_spring_node_vel = ofToString(roundf(selected_node_vel.x * 100) / 100) + ", " + ofToString(roundf(selected_node_vel.y * 100) / 100);
-	gui_spring_node_accel = ofToString(roundf(selected_node_accel.x * 10000) / 10000) + ", " + ofToString(roundf(selected_node_accel.y * 10000) / 10000);
-	gui_spring_node_mass = selected_node_mass;
-	gui_spring_node_radius = selected_node_radius;
+	set_vec_label(gui_spring_node_pos, selected_node_pos, 1);
+	set_vec_label(gui_spring_node_vel, selected_node_vel, 100);
+	set_vec_label(gui_spring_node_accel, selected_node_accel, 10000);
+	set_slider(gui_spring_node_mass, selected_node_mass);
+	set_slider(gui_spring_node_radius, selected_node_radius);
 
 	multi_node_selected_ = true;
 }
 
-void GUIManager::update_spring_values(const ofVec2f anchor_position, const float k, const float damping, const float springmass)
+void GUIManager::update_spring_values(const Vec2 anchor_position, const float k, const float damping, const float springmass)
 {
-	panel_spring_settings.setPosition(cam_->world_to_screen(ofVec2f(HALF_WORLD_WIDTH + anchor_position.x + 8, HALF_WORLD_HEIGHT + anchor_position.y + 8)));
+	panel_spring_settings.setPosition(cam_->world_to_screen(ofVec2f(world::HALF_WORLD_WIDTH + anchor_position.x + 8, world::HALF_WORLD_HEIGHT + anchor_position.y + 8)));
 
-	gui_spring_anchor_pos = ofToString(roundf(anchor_position.x)) + ", " + ofToString(roundf(anchor_position.y));
+	set_vec_label(gui_spring_anchor_pos, anchor_position, 1);
 
-	gui_spring_k = k;
-	gui_spring_damping = damping;
-	gui_spring_springmass = springmass;
+	set_slider(gui_spring_k, k);
+	set_slider(gui_spring_damping, damping);
+	set_slider(gui_spring_springmass, springmass);
 	
 	multi_node_selected_ = false;
 }
 
+void GUIManager::set_label(ofxLabel& label, const string& text)
+{
+	if (static_cast<const string&>(label) != text) label = text;
+}
+
+void GUIManager::set_vec_label(ofxLabel& label, const Vec2 value, const float precision)
+{
+	// compare the rounded value first so unchanged labels skip the string formatting entirely
+	const ofVec2f rounded(roundf(value.x * precision) / precision, roundf(value.y * precision) / precision);
+
+	auto it = label_values_.find(&label);
+	if (it != label_values_.end() && it->second == rounded) return;
+	label_values_[&label] = rounded;
+
+	label = ofToString(rounded.x) + ", " + ofToString(rounded.y);
+}
+
+template<class T>
+void GUIManager::set_slider(ofxSlider<T>& slider, const T value)
+{
+	if (static_cast<const T&>(slider) != value) slider = value;
+}
+
+void GUIManager::set_toggle(ofxToggle& toggle, const bool value)
+{
+	if (static_cast<const bool&>(toggle) != value) toggle = value;
+}
+
+void GUIManager::set_panel_name(ofxPanel& panel, CachedPanel& cached_panel, const string& name)
+{
+	// renaming doesn't go through a parameter event, so the cache is dirtied by hand
+	if (panel.getName() == name) return;
+	panel.setName(name);
+	cached_panel.mark_dirty();
+}
+
 
 
 void GUIManager::draw_required_gui(GameObject* selected_object, const int new_node_id, const string current_gamemode, const bool main_mode_started, const int prev_gamemode)
@@ -346,33 +402,33 @@ void GUIManager::draw_required_gui(GameObject* selected_object, const int new_no
 			{
 				if (selected_object->get_type() == "Mass")
 				{
-					panel_node.draw();
+					cached_panel_node_.draw();
 				}
 				else if (selected_object->get_type() == "Spring")
 				{
 					// if an object is a spring then it has multiple gui windows to draw					
 					if (multi_node_selected_ == true)
 					{
-						panel_spring_node.draw();
+						cached_panel_spring_node_.draw();
 					}
 					else
 					{
-						panel_spring_settings.draw();
+						cached_panel_spring_settings_.draw();
 					}
 				}
 				else if (selected_object->get_type() == "Collectable")
 				{
-					panel_collectable.draw();
+					cached_panel_collectable_.draw();
 				}
 				else if (selected_object->get_type() == "Player")
 				{
-					panel_player.draw();
+					cached_panel_player_.draw();
 				}
 			}
-			panel_world.draw();
-			panel_scene.draw();
-			panel_fluid.draw();
-			panel_perf.draw();
+			cached_panel_world_.draw();
+			cached_panel_scene_.draw();
+			cached_panel_fluid_.draw();
+			cached_panel_perf_.draw();
 		}
 		else
 		{
@@ -381,7 +437,7 @@ void GUIManager::draw_required_gui(GameObject* selected_object, const int new_no
 	}
 }
 
-void GUIManager::draw_text(const int new_node_id, const string current_gamemode) const
+void GUIManager::draw_text(const int new_node_id, const string current_gamemode)
 {
 	string entity_type;
 	switch (new_node_id)
@@ -402,14 +458,14 @@ void GUIManager::draw_text(const int new_node_id, const string current_gamemode)
 
 	if (current_gamemode == "Sandbox")
 	{
-		potta_one_mini_.drawString("Entity Type: " + entity_type, (ofGetWidth() / 2) - potta_one_mini_.stringWidth("Entity Type:____") / 2, ofGetHeight() - (ofGetHeight() / 16));
+		mini_text_.draw("Entity Type: " + entity_type, (ofGetWidth() / 2) - mini_text_.get_width("Entity Type:____") / 2, ofGetHeight() - (ofGetHeight() / 16));
 	}
 	else if (current_gamemode == "Main" || current_gamemode == "Procedural")
 	{
 		if (points_collected_ == max_point_count_)
 		{
-			potta_one_sub_.drawString("Press 'Enter' to move to next level", (ofGetWidth() / 2) - potta_one_sub_.stringWidth("Press 'Enter' to move to next level") / 2, ofGetHeight() - 150);
-			potta_one_mini_.drawString("Or 'Tab' to continue playing", (ofGetWidth() / 2) - potta_one_sub_.stringWidth("Or 'Tab' to continue playing") / 2, ofGetHeight() - 100);
+			sub_text_.draw_centered("Press 'Enter' to move to next level", ofGetWidth() / 2, ofGetHeight() - 150);
+			mini_text_.draw("Or 'Tab' to continue playing", (ofGetWidth() / 2) - sub_text_.get_width("Or 'Tab' to continue playing") / 2, ofGetHeight() - 100);
 		}
 	}
 }
@@ -445,34 +501,34 @@ void GUIManager::draw_menu(const bool main_mode_started, const string current_ga
 
 	// change 'main mode' text depending on if the game has been started
 	(main_mode_started) ? main_mode_text = "Start from beginning" : main_mode_text = "Start";
-	main_mode_bounds = potta_one_main_.getStringBoundingBox(main_mode_text, w - potta_one_main_.stringWidth(main_mode_text) / 2, h + (v_buf * 1));
+	main_mode_bounds = main_text_.get_bounds(main_mode_text, w - main_text_.get_width(main_mode_text) / 2, h + (v_buf * 1));
 
 	// check if mouse is over text bounds and change color accordingly, then draw
 	const ofVec2f mouse_pos = ofVec2f(ofGetMouseX(), ofGetMouseY());
 	
-	potta_one_title_.drawString("Iota", w - potta_one_title_.stringWidth("Iota") / 2, h - (v_buf * 1));
+	title_text_.draw_centered("Iota", w, h - (v_buf * 1));
 	
 	(main_mode_bounds.intersects      (ofRectangle(mouse_pos, 0, 0))) ? ofSetColor(155) : ofSetColor(255);
-	potta_one_main_.drawString(main_mode_text, w - potta_one_main_.stringWidth(main_mode_text) / 2, h + (v_buf * 1));
+	main_text_.draw_centered(main_mode_text, w, h + (v_buf * 1));
 	
 	(procedural_mode_bounds.intersects(ofRectangle(mouse_pos, 0, 0))) ? ofSetColor(155) : ofSetColor(255);	
-	potta_one_main_.drawString(procedural_mode_text, w - potta_one_main_.stringWidth(procedural_mode_text) / 2, h + (v_buf * 2));
+	main_text_.draw_centered(procedural_mode_text, w, h + (v_buf * 2));
 	
 	(sandbox_mode_bounds.intersects   (ofRectangle(mouse_pos, 0, 0))) ? ofSetColor(155) : ofSetColor(255);
-	potta_one_main_.drawString(sandbox_mode_text, w - potta_one_main_.stringWidth(sandbox_mode_text) / 2, h + (v_buf * 3));
+	main_text_.draw_centered(sandbox_mode_text, w, h + (v_buf * 3));
 
 	if (current_gamemode == "Menu" && prev_gamemode == 0)
 	{
 		ofSetColor(255);
-		potta_one_sub_.drawString("Shortcuts", w - potta_one_sub_.stringWidth("Shortcuts") / 2, h + (v_buf * 5));
-		potta_one_mini_.drawString("'c' to create an entity", w - potta_one_mini_.stringWidth("'c' to create an entity") / 2, h + (v_buf * 5.5f));
-		potta_one_mini_.drawString("'x' to delete an entity", w - potta_one_mini_.stringWidth("'x' to delete an entity") / 2, h + (v_buf * 6));
-		potta_one_mini_.drawString("'a'/'d' to change new entity type", w - potta_one_mini_.stringWidth("'a'/'d' to change new entity type") / 2, h + (v_buf * 6.5f));
-		potta_one_mini_.drawString("'rightclick' to select/move entities", w - potta_one_mini_.stringWidth("'rightclick' to select/move entities") / 2, h + (v_buf * 7));
-		potta_one_mini_.drawString("'tab' to toggle camera modes", w - potta_one_mini_.stringWidth("'tab' to toggle camera modes") / 2, h + (v_buf * 7.5f));
-		potta_one_mini_.drawString("'scrollwheel' to zoom/pan", w - potta_one_mini_.stringWidth("'scrollwheel' to zoom/pan") / 2, h + (v_buf * 8));
-		potta_one_mini_.drawString("'r' to reset zoom", w - potta_one_mini_.stringWidth("'r' to reset zoom") / 2, h + (v_buf * 8.5f));
-		potta_one_mini_.drawString("'f' to 'shuffle' fluid", w - potta_one_mini_.stringWidth("'f' to 'shuffle' fluid") / 2, h + (v_buf * 9.0f));
+		sub_text_.draw_centered("Shortcuts", w, h + (v_buf * 5));
+		mini_text_.draw_centered("'c' to create an entity", w, h + (v_buf * 5.5f));
+		mini_text_.draw_centered("'x' to delete an entity", w, h + (v_buf * 6));
+		mini_text_.draw_centered("'a'/'d' to change new entity type", w, h + (v_buf * 6.5f));
+		mini_text_.draw_centered("'rightclick' to select/move entities", w, h + (v_buf * 7));
+		mini_text_.draw_centered("'tab' to toggle camera modes", w, h + (v_buf * 7.5f));
+		mini_text_.draw_centered("'scrollwheel' to zoom/pan", w, h + (v_buf * 8));
+		mini_text_.draw_centered("'r' to reset zoom", w, h + (v_buf * 8.5f));
+		mini_text_.draw_centered("'f' to 'shuffle' fluid", w, h + (v_buf * 9.0f));
 	}
 	
 	ofPopMatrix();
@@ -485,9 +541,9 @@ void GUIManager::window_resized()
 	const float w = ofGetWidth() / 2;
 	const float h = ofGetHeight() / 2;
 	const float v_buf = 48;	
-	main_mode_bounds = potta_one_main_.getStringBoundingBox(main_mode_text, w - potta_one_main_.stringWidth(main_mode_text) / 2, h + (v_buf * 1));
-	procedural_mode_bounds = potta_one_main_.getStringBoundingBox("Procedural Mode", w - potta_one_main_.stringWidth("Procedural Mode") / 2, h + (v_buf * 2));
-	sandbox_mode_bounds = potta_one_main_.getStringBoundingBox("Sandbox Mode", w - potta_one_main_.stringWidth("Sandbox Mode") / 2, h + (v_buf * 3));
+	main_mode_bounds = main_text_.get_bounds(main_mode_text, w - main_text_.get_width(main_mode_text) / 2, h + (v_buf * 1));
+	procedural_mode_bounds = main_text_.get_bounds("Procedural Mode", w - main_text_.get_width("Procedural Mode") / 2, h + (v_buf * 2));
+	sandbox_mode_bounds = main_text_.get_bounds("Sandbox Mode", w - main_text_.get_width("Sandbox Mode") / 2, h + (v_buf * 3));
 }
 
 void GUIManager::key_pressed(const int key)
@@ -1,13 +1,31 @@
 #pragma once
 
+#include "AllocationTracker.h"
 #include "AudioManager.h"
+#include "CachedPanel.h"
 #include "Camera.h"
 #include "Controller.h"
+#include "core/Vec2.h"
+#include "GlyphRunCache.h"
+#include "GpuTimer.h"
 #include "ofMain.h"
 #include "ofxGui.h"
 
+#include <mutex>
+
 class GameObject;
 
+// buttons pressed on the main thread, applied by apply_commands() while the simulation mutex is held
+enum GuiCommand
+{
+	GUI_COMMAND_DELETE_ALL,
+	GUI_COMMAND_NEW_SCENE,
+	GUI_COMMAND_SAVE_SCENE,
+	GUI_COMMAND_QUICKLOAD_SCENE,
+	GUI_COMMAND_LOAD_SCENE,
+	GUI_COMMAND_RESET_FLUID
+};
+
 class GUIManager
 {
 public:
@@ -15,14 +33,16 @@ public:
 	GUIManager();
 
 	void init(Controller* controller, AudioManager* audio_manager, Camera* cam);
+	void load_fonts(AssetManager& assets);
 	
 	void update();
 	void update_world();
-	void update_player_values(ofVec2f pos, ofVec2f vel, ofVec2f accel, float mass, bool infmass, float radius);
-	void update_mass_values(ofVec2f pos, ofVec2f vel, ofVec2f accel, float mass, float radius);
-	void update_collectable_values(ofVec2f pos, ofVec2f vel, ofVec2f accel, float radius, float emission_frequency, float emission_force, bool is_active, int id);
-	void update_spring_values(ofVec2f anchor_position, float k, float damping, float springmass);
-	void update_spring_values(ofVec2f anchor_position, float k, float damping, float springmass, ofVec2f selected_node_pos, ofVec2f selected_node_vel, ofVec2f selected_node_accel, float selected_node_mass, float selected_node_radius);
+	void update_player_values(Vec2 pos, Vec2 vel, Vec2 accel, float mass, bool infmass, float radius);
+	void update_mass_values(Vec2 pos, Vec2 vel, Vec2 accel, float mass, float radius);
+	void update_collectable_values(Vec2 pos, Vec2 vel, Vec2 accel, float radius, float emission_frequency, float emission_force, bool is_active, int id);
+	void update_spring_values(Vec2 anchor_position, float k, float damping, float springmass);
+	void update_spring_values(Vec2 anchor_position, float k, float damping, float springmass, Vec2 selected_node_pos, Vec2 selected_node_vel, Vec2 selected_node_accel, float selected_node_mass, float selected_node_radius);
+	void update_render_scale_values(float render_scale, float average_frame_time);
 
 	int get_max_point_count();
 	void set_max_point_count(int count);
@@ -30,20 +50,21 @@ public:
 	void set_point_count(int count);
 	void reset_point_counters();
 
-	// listeners
-	void toggle_delete_all();
-	void toggle_new_scene();
-	void toggle_save_scene();
-	void toggle_quickload_scene();
-	void toggle_load_scene();
+	// called at the start of each step with the simulation mutex held, turns queued button presses into requests
+	void apply_commands();
 	void reset_fluid_settings();
 
 	// getters / setters
-	int get_delete_all() const;
-	bool get_request_new_scene() const;
-	bool get_request_save_scene() const;
-	bool get_request_quickload_scene() const;
-	bool get_request_load_scene() const;
+	bool get_request_delete_all() const				{ return request_delete_all_; }
+	void set_request_delete_all(bool value)			{ request_delete_all_ = value; }
+	bool get_request_new_scene() const				{ return request_new_scene_; }
+	void set_request_new_scene(bool value)			{ request_new_scene_ = value; }
+	bool get_request_save_scene() const				{ return request_save_scene_; }
+	void set_request_save_scene(bool value)			{ request_save_scene_ = value; }
+	bool get_request_quickload_scene() const		{ return request_quickload_scene_; }
+	void set_request_quickload_scene(bool value)	{ request_quickload_scene_ = value; }
+	bool get_request_load_scene() const				{ return request_load_scene_; }
+	void set_request_load_scene(bool value)			{ request_load_scene_ = value; }
 
 	void set_gui_visible(bool value);
 	bool get_gui_visible() const;
@@ -101,6 +122,14 @@ public:
 	// Performance
 	ofxLabel gui_perf_fps;
 	ofxLabel gui_perf_frametime;
+	ofxToggle gui_perf_dynamic_resolution;
+	ofxLabel gui_perf_render_scale;
+	ofxLabel gui_perf_gpu;
+	ofxLabel gui_perf_allocations;
+	ofxToggle gui_perf_show_task_graph;
+	ofxToggle gui_perf_show_profiler;
+	ofxToggle gui_perf_show_allocations;
+	ofxFloatSlider gui_perf_spike_threshold;
 	
 	// Player
 	ofxLabel gui_player_pos;
@@ -149,10 +178,26 @@ public:
 
 private:		
 	
+	// button listeners - these fire on the main thread outside the simulation mutex, so they only queue
+	void queue_command(GuiCommand command);
+	void on_delete_all_pressed()			{ queue_command(GUI_COMMAND_DELETE_ALL); }
+	void on_new_scene_pressed()				{ queue_command(GUI_COMMAND_NEW_SCENE); }
+	void on_save_scene_pressed()			{ queue_command(GUI_COMMAND_SAVE_SCENE); }
+	void on_quickload_scene_pressed()		{ queue_command(GUI_COMMAND_QUICKLOAD_SCENE); }
+	void on_load_scene_pressed()			{ queue_command(GUI_COMMAND_LOAD_SCENE); }
+	void on_reset_fluid_pressed()			{ queue_command(GUI_COMMAND_RESET_FLUID); }
+
 	// Draw
-	void draw_text(int new_node_id, string current_gamemode) const;
+	void draw_text(int new_node_id, string current_gamemode);
 	void draw_border() const;
 	void draw_menu(bool main_mode_started, string current_gamemode, int prev_gamemode);
+
+	// dirty tracking - the setters leave a control untouched (and its panel cached) when the value hasn't changed
+	void set_label(ofxLabel& label, const string& text);
+	void set_vec_label(ofxLabel& label, Vec2 value, float precision);
+	template<class T> void set_slider(ofxSlider<T>& slider, T value);
+	void set_toggle(ofxToggle& toggle, bool value);
+	void set_panel_name(ofxPanel& panel, CachedPanel& cached_panel, const string& name);
 	
 	Controller* game_controller_{};
 	AudioManager* audio_manager_{};
@@ -174,9 +219,29 @@ private:
 	bool request_quickload_scene_;
 	bool request_load_scene_;
 
-	ofTrueTypeFont potta_one_title_;
-	ofTrueTypeFont potta_one_main_;
-	ofTrueTypeFont potta_one_sub_;
-	ofTrueTypeFont potta_one_mini_;
+	std::mutex commands_mutex_;
+	vector<GuiCommand> pending_commands_;		// guarded by commands_mutex_
+	vector<GuiCommand> applied_commands_;		// swapped with pending_commands_ so neither reallocates once warm
+
+	// fonts are owned by the asset manager
+	GlyphRunCache title_text_;
+	GlyphRunCache main_text_;
+	GlyphRunCache sub_text_;
+	GlyphRunCache mini_text_;
+
+	CachedPanel cached_panel_world_;
+	CachedPanel cached_panel_scene_;
+	CachedPanel cached_panel_fluid_;
+	CachedPanel cached_panel_perf_;
+	CachedPanel cached_panel_player_;
+	CachedPanel cached_panel_node_;
+	CachedPanel cached_panel_collectable_;
+	CachedPanel cached_panel_spring_settings_;
+	CachedPanel cached_panel_spring_node_;
+
+	unordered_map<const ofxLabel*, ofVec2f> label_values_;	// last rounded value shown by each vector label
+	uint64_t last_perf_update_;
+	float shown_render_scale_;
+	float shown_average_frame_time_;
 
 };
@@ -13,8 +13,12 @@ GamemodeManager::GamemodeManager(const int game_mode_id)
 	,	main_mode_started_(false)
 {
 	log_current_mode();
+}
 
-	potta_one_main_.load("Fonts/PottaOne-Regular.ttf", 12, true, true);
+// needs a GL context - skipped when running headless
+void GamemodeManager::load_fonts(AssetManager& assets)
+{
+	main_text_.setup(assets.get_font("Fonts/PottaOne-Regular.ttf", 12));
 }
 
 void GamemodeManager::init(GUIManager* gui_manager)
@@ -34,11 +38,11 @@ void GamemodeManager::draw()
 		ofPushMatrix();
 		ofPushStyle();
 		ofSetColor(0, 0, 0, fill_alpha_);
-		ofDrawRectangle(0, 0, WORLD_WIDTH, WORLD_HEIGHT);
+		ofDrawRectangle(0, 0, world::WORLD_WIDTH, world::WORLD_HEIGHT);
 		ofSetColor(255, 255, 255, text_alpha1_);
-		potta_one_main_.drawString("Click to propell yourself", HALF_WORLD_WIDTH - potta_one_main_.stringWidth("Click to propell yourself") / 2, HALF_WORLD_HEIGHT - potta_one_main_.stringHeight("Click to propell yourself"));
+		main_text_.draw_centered("Click to propell yourself", world::HALF_WORLD_WIDTH, world::HALF_WORLD_HEIGHT - main_text_.get_height("Click to propell yourself"));
 		ofSetColor(255, 255, 255, text_alpha2_);
-		potta_one_main_.drawString("Follow the trail", HALF_WORLD_WIDTH - potta_one_main_.stringWidth("Follow the trail") / 2, HALF_WORLD_HEIGHT - potta_one_main_.stringHeight("Follow the trail") + 40);
+		main_text_.draw_centered("Follow the trail", world::HALF_WORLD_WIDTH, world::HALF_WORLD_HEIGHT - main_text_.get_height("Follow the trail") + 40);
 		ofPopStyle();
 		ofPopMatrix();
 	}
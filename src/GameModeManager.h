@@ -2,6 +2,7 @@
 
 #include "ofMain.h"
 #include "Controller.h"
+#include "GlyphRunCache.h"
 #include "GUIManager.h"
 
 class GamemodeManager
@@ -10,6 +11,7 @@ public:
 
 	GamemodeManager(int game_mode_id = 0);
 	void init(GUIManager* gui_manager);
+	void load_fonts(AssetManager& assets);
 
 	void update();
 
@@ -69,6 +71,6 @@ private:
 
 	bool main_mode_started_;
 
-	ofTrueTypeFont potta_one_main_;
+	GlyphRunCache main_text_; // font owned by the asset manager
 
 };
@@ -6,18 +6,10 @@ GameObject::GameObject(const ofVec2f pos, const ofColor color)
 	  gui_manager_(nullptr),
 	  fluid_manager_(nullptr),
 	  audio_manager_(nullptr),
+	  step_input_(nullptr),
 	  cam_(nullptr),
-	  pos_(pos),
-	  prev_pos_(99999, 99999),
-	  mass_(10),
-	  radius_(35),
-	  vel_(0),
-	  accel_(0),
+	  batch_renderer_(nullptr),
 	  color_(color),
-	  infinite_mass_(false),
-	  affected_by_gravity_(false),
-	  gravity_mult_(1),
-	  collision_mult_(1),
 	  mouse_over_(false),
 	  mouse_over_radius_mult_(1),
 	  mouse_over_index_(0),
@@ -25,6 +17,7 @@ GameObject::GameObject(const ofVec2f pos, const ofColor color)
 	  mouse_drag_(false),
 	  mouse_offset_from_center_(0),
 	  local_mouse_pos_before_drag_(0),
+	  world_mouse_pos_before_drag_(0),
 	  pixel_buffer_before_drag_(0),
 	  started_dragging_(false),
 	  passive_color_(ofColor(255, 255, 255)),
@@ -41,9 +34,10 @@ GameObject::GameObject(const ofVec2f pos, const ofColor color)
 	  mouse_hover_enabled_(false),
 	  ellipse_collider_enabled_(false)
 {
+	body_.pos = Vec2(pos);
 }
 
-void GameObject::init(vector<GameObject*>* gameobjects, Controller* controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager)
+void GameObject::init(vector<GameObject*>* gameobjects, Controller* controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager, const StepInput* step_input, BatchRenderer* batch_renderer)
 {
 	game_objects_ = gameobjects;
 	game_controller_ = controller;
@@ -51,8 +45,24 @@ void GameObject::init(vector<GameObject*>* gameobjects, Controller* controller,
 	fluid_manager_ = fluid_manager;
 	audio_manager_ = audio_manager;
 	gamemode_manager_ = gamemode_manager;
+	step_input_ = step_input;
 
 	cam_ = cam;
+	batch_renderer_ = batch_renderer;
+}
+
+// phase one of the entity step - runs on the job pool, so nothing in here may write to another object or to shared state
+void GameObject::root_compute_interactions()
+{
+	contacts_.clear();
+	if (request_to_be_deleted_) return;
+
+	if (ellipse_collider_enabled_)
+	{
+		find_contacts();
+	}
+
+	compute_interactions();
 }
 
 // root update is called prir to the main update function of a gameobject and is responsible for handling object deletion and updating user-added modules - it automatically updates the main update funcion
@@ -70,19 +80,19 @@ void GameObject::root_update()
 	{
 		if (screen_wrap_enabled_)
 		{
-			screen_wrap();
+			body_.screen_wrap();
 		}
 		if (screen_bounce_enabled_)
 		{
-			screen_bounce();
+			body_.screen_bounce();
 		}
 		if (gravity_enabled_)
 		{
-			gravity();
+			body_.gravity(game_controller_->get_gravity() == 1);
 		}
 		if (friction_enabled_)
 		{
-			friction();
+			body_.friction();
 		}
 		if (ellipse_collider_enabled_)
 		{
@@ -93,7 +103,7 @@ void GameObject::root_update()
 			mouse_hover();
 		}
 
-		prev_pos_ = pos_;
+		body_.prev_pos = body_.pos;
 
 		update(); // <--- user defined update function for every gameobject
 	}
@@ -141,83 +151,8 @@ void GameObject::add_module(const string id)
 	}
 }
 
-// upon reaching the screen edge, the object is placed at the opposite edge
-void GameObject::screen_wrap()
-{
-	if (pos_.x > 0 + (HALF_WORLD_WIDTH))
-	{
-		pos_.x = 0 - (HALF_WORLD_WIDTH);
-	}
-	if (pos_.x < 0 - (HALF_WORLD_WIDTH))
-	{
-		pos_.x = 0 + (HALF_WORLD_WIDTH);
-	}
-	if (pos_.y < 0 - (HALF_WORLD_HEIGHT))
-	{
-		pos_.y = 0 + (HALF_WORLD_HEIGHT);
-	}
-	if (pos_.y > 0 + (HALF_WORLD_HEIGHT))
-	{
-		pos_.y = 0 - (HALF_WORLD_HEIGHT);
-	}
-}
-
-// object 'bounce' when hitting the screen edge
-void GameObject::screen_bounce()
-{
-	if (node_positions_.empty())
-	{
-		if (pos_.x > 0 + (HALF_WORLD_WIDTH) - (radius_) / 2)
-		{
-			vel_.x *= -1;
-			pos_.x = 0 + (HALF_WORLD_WIDTH) - (radius_) / 2;
-		}
-		if (pos_.x < 0 - (HALF_WORLD_WIDTH) + (radius_) / 2)
-		{
-			vel_.x *= -1;
-			pos_.x = 0 - (HALF_WORLD_WIDTH) + (radius_) / 2;
-		}
-		if (pos_.y < 0 - (HALF_WORLD_HEIGHT) + (radius_) / 2)
-		{
-			vel_.y *= -1;
-			pos_.y = 0 - (HALF_WORLD_HEIGHT) + (radius_) / 2;
-		}
-		if (pos_.y > 0 + (HALF_WORLD_HEIGHT) - (radius_) / 2)
-		{
-			vel_.y *= -1;
-			pos_.y = 0 + (HALF_WORLD_HEIGHT) - (radius_) / 2;
-		}
-	}
-	else
-	{
-		for (int i = 0; i < node_positions_.size(); i++)
-		{
-			if (node_positions_[i].x > 0 + (HALF_WORLD_WIDTH) - (node_radiuses_[i]) / 2)
-			{
-				node_velocities_[i].x *= -1;
-				node_positions_[i].x = 0 + (HALF_WORLD_WIDTH) - (node_radiuses_[i]) / 2;
-			}
-			if (node_positions_[i].x < 0 - (HALF_WORLD_WIDTH) + (node_radiuses_[i]) / 2)
-			{
-				node_velocities_[i].x *= -1;
-				node_positions_[i].x = 0 - (HALF_WORLD_WIDTH) + (node_radiuses_[i]) / 2;
-			}
-			if (node_positions_[i].y < 0 - (HALF_WORLD_HEIGHT) + (node_radiuses_[i]) / 2)
-			{
-				node_velocities_[i].y *= -1;
-				node_positions_[i].y = 0 - (HALF_WORLD_HEIGHT) + (node_radiuses_[i]) / 2;
-			}
-			if (node_positions_[i].y > 0 + (HALF_WORLD_HEIGHT) - (node_radiuses_[i]) / 2)
-			{
-				node_velocities_[i].y *= -1;
-				node_positions_[i].y = 0 + (HALF_WORLD_HEIGHT) - (node_radiuses_[i]) / 2;
-			}
-		}
-	}
-}
-
 // simple ellipse collision detection
-void GameObject::ellipse_collider()
+void GameObject::find_contacts()
 {
 	for (auto& game_object : *game_objects_)
 	{
@@ -227,82 +162,27 @@ void GameObject::ellipse_collider()
 			{
 				if (game_object->type_ != "Spring")
 				{
-					if (Collisions::ellipse_compare(pos_, radius_, game_object->pos_, game_object->radius_))
+					if (Collisions::ellipse_compare(body_.pos, body_.radius, game_object->body_.pos, game_object->body_.radius))
 					{
-						is_colliding(game_object);
+						contacts_.push_back({ game_object, game_object->body_.pos, -1 });
 					}
 				}
 			}
 		}
 	}
 }
-// called when an object is currently colliding
-void GameObject::is_colliding(GameObject* other, const ofVec2f node_pos)
-{
-	ofVec2f other_pos;
-	if (other->type_ == "Spring")
-	{
-		other_pos = node_pos;
-	}
-	else
-	{
-		other_pos = other->pos_;
-	}
-
-	if (game_controller_->get_use_hard_collisions())
-	{
-		const ofVec2f force_vec = pos_ - other_pos;
-		if (prev_pos_ != ofVec2f(99999, 99999)) pos_ = prev_pos_;
-		//vel.set(0);
-		apply_force(accel_, (force_vec / mass_), false);
-	}
-	else
-	{
-		const ofVec2f force_vec = pos_ - other_pos;
-		apply_force(accel_, (force_vec / mass_), true);
-	}
-}
 
-void GameObject::gravity()
+void GameObject::ellipse_collider()
 {
-	if (node_positions_.empty())
-	{
-		if (game_controller_->get_gravity() == 1 || affected_by_gravity_)
-		{
-			const ofVec2f new_force = {0, static_cast<float>(GRAVITY_FORCE) * gravity_mult_ * mass_};
-			apply_force(accel_, new_force, false);
-		}
-	}
-	else
+	for (auto& contact : contacts_)
 	{
-		for (int i = 0; i < node_positions_.size(); i++)
-		{
-			if (game_controller_->get_gravity() == 1 || affected_by_gravity_)
-			{
-				const ofVec2f new_force = {0, static_cast<float>(GRAVITY_FORCE) * gravity_mult_ * node_masses_[i]};
-				apply_force(node_accelerations_[i], new_force, false);
-			}
-		}
+		is_colliding(contact.other, contact.other_pos);
 	}
 }
-
-void GameObject::friction()
+// called when an object is currently colliding
+void GameObject::is_colliding(GameObject* other, const Vec2 other_pos)
 {
-	if (node_positions_.empty())
-	{
-		ofVec2f friction = vel_ * -1;
-		friction *= FRICTION_FORCE;
-		apply_force(accel_, friction, true);
-	}
-	else
-	{
-		for (int i = 0; i < node_positions_.size(); i++)
-		{
-			ofVec2f friction = node_velocities_[i] * -1;
-			friction *= FRICTION_FORCE;
-			apply_force(accel_, friction, false);
-		}
-	}
+	body_.collide(other_pos, game_controller_->get_use_hard_collisions());
 }
 
 // determines if the mouse is over an object
@@ -310,14 +190,14 @@ void GameObject::mouse_hover()
 {
 	if (gamemode_manager_->get_current_mode_string() == "Sandbox")
 	{
-		if (node_positions_.empty())
+		if (!body_.has_nodes())
 		{
 			if (game_controller_->get_mouse_dragged() == false)
 			{
-				if (Collisions::ellipse_compare(pos_, get_radius() * mouse_over_radius_mult_, ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y), 0))
+				if (Collisions::ellipse_compare(body_.pos, get_radius() * mouse_over_radius_mult_, Vec2(cam_->get_world_mouse_pos()), 0))
 				{
 					mouse_over_ = true;
-					mouse_offset_from_center_ = pos_ - cam_->get_world_mouse_pos();
+					mouse_offset_from_center_ = get_position() - cam_->get_world_mouse_pos();
 				}
 				else {
 					mouse_over_ = false;
@@ -327,20 +207,20 @@ void GameObject::mouse_hover()
 		else {
 			if (game_controller_->get_mouse_dragged() == false)
 			{
-				for (int i = 0; i < node_positions_.size(); i++)
+				for (int i = 0; i < body_.node_positions.size(); i++)
 				{
-					if (Collisions::ellipse_compare(node_positions_[i], node_radiuses_[i], cam_->get_world_mouse_pos(), 0))
+					if (Collisions::ellipse_compare(body_.node_positions[i], body_.node_radiuses[i], Vec2(cam_->get_world_mouse_pos()), 0))
 					{
 						mouse_over_ = true;
 						mouse_over_index_ = i;
-						mouse_offset_from_center_ = node_positions_[i] - cam_->get_world_mouse_pos();
+						mouse_offset_from_center_ = body_.node_positions[i].to<ofVec2f>() - cam_->get_world_mouse_pos();
 						break;
 					}
-					else if (Collisions::ellipse_compare(pos_, get_radius() * mouse_over_radius_mult_, cam_->get_world_mouse_pos(), 0))
+					else if (Collisions::ellipse_compare(body_.pos, get_radius() * mouse_over_radius_mult_, Vec2(cam_->get_world_mouse_pos()), 0))
 					{
 						mouse_over_ = true;
 						mouse_over_index_ = -1;
-						mouse_offset_from_center_ = pos_ - cam_->get_world_mouse_pos();
+						mouse_offset_from_center_ = get_position() - cam_->get_world_mouse_pos();
 						break;
 					}
 					else {
@@ -357,54 +237,6 @@ void GameObject::mouse_hover()
 }
 
 
-// Shared physics functions
-
-
-void GameObject::apply_force(ofVec2f& accel, ofVec2f force, const bool limit, const float limit_amount)
-{
-	if (limit)
-	{
-		force.limit(limit_amount);
-		accel += force;
-	}
-	else
-	{
-		accel += force;
-		add_forces(false);
-	}
-}
-
-void GameObject::add_forces(const bool interp_pos)
-{
-	if (node_positions_.empty())
-	{
-		vel_ += accel_;
-		vel_.limit(MAXIMUM_VELOCITY);
-		if (interp_pos)
-		{
-			pos_ = get_interpolated_position();
-		}
-		else
-		{
-			pos_ += vel_;
-		}
-	}
-}
-
-ofVec2f GameObject::get_interpolated_position()
-{
-	const int progress = (ofGetFrameNum() % 100) / 100;
-	ofVec2f pow_interp_in;
-	pow_interp_in.x = ofNextPow2(progress);
-	pow_interp_in.y = ofNextPow2(progress);
-
-	ofVec2f new_pos;
-	new_pos.x = ofLerp(pos_.x, pos_.x + vel_.x, pow_interp_in.x);
-	new_pos.y = ofLerp(pos_.y, pos_.y + vel_.y, pow_interp_in.y);
-	return new_pos;
-}
-
-
 // ----- EVENT FUNCTIONS ----- //
 
 
@@ -437,4 +269,22 @@ void GameObject::root_draw()
 	{
 		draw();
 	}
+}
+
+bool GameObject::is_within(const ofRectangle& rect) const
+{
+	// radiuses are used as draw diameters, so padding by the full value is conservative
+	const auto overlaps = [&rect](const Vec2& pos, const float size)
+	{
+		return pos.x + size >= rect.x && pos.x - size <= rect.x + rect.width && pos.y + size >= rect.y && pos.y - size <= rect.y + rect.height;
+	};
+
+	if (overlaps(body_.pos, body_.radius)) return true;
+
+	// springs are visible if any of their nodes are
+	for (int i = 0; i < body_.node_positions.size(); i++)
+	{
+		if (overlaps(body_.node_positions[i], body_.node_radiuses[i])) return true;
+	}
+	return false;
 }
\ No newline at end of file
@@ -1,23 +1,42 @@
 #pragma once
 
 #include "AudioManager.h"
-#include "Collisions.h"
+#include "BatchRenderer.h"
+#include "core/Body.h"
+#include "core/Collisions.h"
 #include "Controller.h"
 #include "Camera.h"
 #include "FluidManager.h"
 #include "GUIManager.h"
 #include "ofMain.h"
 #include "GamemodeManager.h"
+#include "core/ObjectPool.h"
+#include "core/StepInput.h"
+
+class GameObject;
+
+// a collision found during the compute phase of the entity step
+// the position is the other object's (or the colliding spring node's) as it was at the start of the step
+struct Contact {
+	GameObject* other;
+	Vec2 other_pos;
+	int node_index;	// this object's node for springs, -1 otherwise
+};
 
 class GameObject {
 	
 public:
 
 	GameObject(ofVec2f pos = { 0, 0 }, ofColor color = ofColor(255));
-	void init(vector<GameObject*>* gameobjects, Controller* controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager);
+	virtual ~GameObject() = default;
+	void init(vector<GameObject*>* gameobjects, Controller* controller, GUIManager* gui_manager, Camera* cam, FluidManager* fluid_manager, AudioManager* audio_manager, GamemodeManager* gamemode_manager, const StepInput* step_input, BatchRenderer* batch_renderer);
 
+	// the entity step runs in two phases - compute_interactions only reads other objects and writes this object's buffers, so every object can run it in parallel
+	// root_update then applies the buffers in list order, together with everything that has side effects (fluid, audio, gui, statics)
+	void root_compute_interactions();
 	void root_update();
 	void root_draw();
+	bool is_within(const ofRectangle& rect) const;
 
 	void root_key_pressed(int key);
 	void root_key_released(int key);
@@ -26,30 +45,35 @@ public:
 	virtual void mouse_dragged(float x, float y, int button) {}
 	virtual void mouse_released(float x, float y, int button) {}
 
-	string get_type() const											{ return type_; }
+	PoolHandle get_handle() const									{ return handle_; }
+	void set_handle(const PoolHandle handle)						{ handle_ = handle; }
+
+	const string& get_type() const									{ return type_; }
 	void set_type(const string type)								{ type_ = type;  }
 	
-	ofVec2f get_position() const									{ return pos_; }
-	void set_position(const ofVec2f pos)							{ pos_ = pos; }
+	const Body& get_body() const									{ return body_; }
+
+	ofVec2f get_position() const									{ return body_.pos.to<ofVec2f>(); }
+	void set_position(const Vec2 pos)								{ body_.pos = pos; }
 
-	ofVec2f get_velocity() const									{ return vel_; }
-	void set_velocity(const ofVec2f vel)							{ vel_ = vel; }
+	ofVec2f get_velocity() const									{ return body_.vel.to<ofVec2f>(); }
+	void set_velocity(const Vec2 vel)								{ body_.vel = vel; }
 
-	ofVec2f get_accel() const										{ return accel_; }
-	void set_accel(const ofVec2f accel)								{ accel_ = accel; }
+	ofVec2f get_accel() const										{ return body_.accel.to<ofVec2f>(); }
+	void set_accel(const Vec2 accel)								{ body_.accel = accel; }
 	
-	float get_radius() const										{ return radius_; }
-	void set_radius(const float radius)								{ radius_ = radius; }
+	float get_radius() const										{ return body_.radius; }
+	void set_radius(const float radius)								{ body_.radius = radius; }
 	
-	float get_mass() const											{ return mass_; }
-	void set_mass(const float mass)									{ mass_ = mass; }
+	float get_mass() const											{ return body_.mass; }
+	void set_mass(const float mass)									{ body_.mass = mass; }
 
 	ofColor get_color() const										{ return color_; }
 	void set_color(const ofColor color)								{ color_ = color; }
 	
-	vector<ofVec2f> get_multiple_positions() const					{ return node_positions_; }
-	vector<float> get_multiple_radiuses() const						{ return node_radiuses_; }
-	vector<float> get_multiple_masses() const						{ return node_masses_; }	
+	const vector<Vec2>& get_multiple_positions() const				{ return body_.node_positions; }
+	vector<float> get_multiple_radiuses() const						{ return body_.node_radiuses; }
+	vector<float> get_multiple_masses() const						{ return body_.node_masses; }	
 
 	virtual float get_attribute_by_name(const string name) const	{ return -1; }
 	
@@ -67,17 +91,13 @@ public:
 
 	bool can_collide() const										{ return ellipse_collider_enabled_; }
 	
-	virtual void is_colliding(GameObject* other, ofVec2f node_pos = { 0, 0 });
-
-	virtual void apply_force(ofVec2f& accel, ofVec2f force, bool limit = true, float limit_amount = MAXIMUM_ACCELERATION);
-	virtual void add_forces(bool interp_pos);
+	virtual void is_colliding(GameObject* other, Vec2 other_pos);
 
 protected:
 
 	void add_module(string id);	
-	
-	virtual ofVec2f get_interpolated_position();
 
+	virtual void compute_interactions(){}
 	virtual void update(){}
 	virtual void draw(){}
 
@@ -90,33 +110,22 @@ protected:
 	FluidManager* fluid_manager_;
 	AudioManager* audio_manager_;
 	GamemodeManager* gamemode_manager_;
+	const StepInput* step_input_; // this frame's mouse, window size and frame number - never ask oF from the step
 
 	Camera* cam_;
+	BatchRenderer* batch_renderer_;
 
 	Collisions collision_detector_;
 
+	vector<Contact> contacts_; // filled by find_contacts, applied by ellipse_collider
+
+	PoolHandle handle_; // slot in the EntityManager pools, invalid for objects that are not owned by a pool
+
 	string type_;
 	
-	ofVec2f pos_;
-	ofVec2f prev_pos_;
-	float mass_;
-	float radius_;	
-
-	vector<ofVec2f> node_positions_;
-	vector<ofVec2f> node_velocities_;
-	vector<ofVec2f> node_accelerations_;
-	vector<float> node_radiuses_;
-	vector<float> node_masses_;
-	
-	ofVec2f vel_;
-	ofVec2f accel_;
+	Body body_; // position, motion, mass and nodes - everything the physics modules touch
 	
 	ofColor color_;
-	
-	bool infinite_mass_;
-	bool affected_by_gravity_;
-	int gravity_mult_;
-	int collision_mult_;
 		
 	bool mouse_over_;
 	float mouse_over_radius_mult_;
@@ -126,6 +135,7 @@ protected:
 	bool mouse_drag_;
 	ofVec2f mouse_offset_from_center_;
 	ofVec2f local_mouse_pos_before_drag_;
+	ofVec2f world_mouse_pos_before_drag_; // where the mouse was last frame while dragging, for the release velocity
 	float pixel_buffer_before_drag_;
 	bool started_dragging_;
 
@@ -144,12 +154,9 @@ protected:
 
 private:
 	
-	// Modules
-	virtual void screen_wrap();
-	virtual void screen_bounce();
-	virtual void gravity();
-	virtual void friction();
+	// Modules - the physics ones are Body's
 	virtual void mouse_hover();
+	virtual void find_contacts();
 	virtual void ellipse_collider();
 
 	bool screen_wrap_enabled_;
@@ -0,0 +1,61 @@
+#include "GlyphRunCache.h"
+
+GlyphRunCache::GlyphRunCache()
+	:	font_(nullptr)
+{
+}
+
+void GlyphRunCache::setup(const ofTrueTypeFont* font)
+{
+	font_ = font;
+	runs_.clear();
+}
+
+void GlyphRunCache::clear()
+{
+	runs_.clear();
+}
+
+const GlyphRun& GlyphRunCache::get(const string& text)
+{
+	// headless, or before the fonts are loaded - nothing to lay out, and nothing is cached
+	static const GlyphRun empty_run{ {}, {}, 0, 0 };
+	if (font_ == nullptr || !font_->isLoaded()) return empty_run;
+
+	auto it = runs_.find(text);
+	if (it != runs_.end()) return it->second;
+
+	GlyphRun& run = runs_[text];
+	run.mesh = font_->getStringMesh(text, 0, 0);
+	run.bounds = font_->getStringBoundingBox(text, 0, 0);
+	run.width = font_->stringWidth(text);
+	run.height = font_->stringHeight(text);
+	return run;
+}
+
+void GlyphRunCache::draw(const string& text, const float x, const float y)
+{
+	if (font_ == nullptr || !font_->isLoaded()) return;
+
+	const GlyphRun& run = get(text);
+
+	ofPushMatrix();
+	ofTranslate(x, y);
+	font_->getFontTexture().bind();
+	run.mesh.draw();
+	font_->getFontTexture().unbind();
+	ofPopMatrix();
+}
+
+void GlyphRunCache::draw_centered(const string& text, const float center_x, const float y)
+{
+	draw(text, center_x - get_width(text) / 2, y);
+}
+
+ofRectangle GlyphRunCache::get_bounds(const string& text, const float x, const float y)
+{
+	ofRectangle bounds = get(text).bounds;
+	bounds.x += x;
+	bounds.y += y;
+	return bounds;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ofMain.h"
+
+// a string laid out once into a textured mesh, positioned relative to the baseline origin
+struct GlyphRun {
+	ofVboMesh mesh;
+	ofRectangle bounds;
+	float width;
+	float height;
+};
+
+// pre-shaped text for one font - each distinct string is laid out the first time it's used, afterwards drawing it is just a bind of the glyph atlas and one mesh draw
+// meant for the fixed strings of menus and prompts, dynamic text should still go through the font directly
+class GlyphRunCache {
+
+public:
+
+	GlyphRunCache();
+
+	// font is owned elsewhere (the asset manager), null until it's loaded
+	void setup(const ofTrueTypeFont* font);
+	void clear();
+
+	const GlyphRun& get(const string& text);
+
+	void draw(const string& text, float x, float y);
+	void draw_centered(const string& text, float center_x, float y);
+
+	float get_width(const string& text)		{ return get(text).width; }
+	float get_height(const string& text)		{ return get(text).height; }
+	ofRectangle get_bounds(const string& text, float x, float y);
+
+private:
+
+	const ofTrueTypeFont* font_;
+	unordered_map<string, GlyphRun> runs_;
+
+};
@@ -0,0 +1,105 @@
+#include "GpuTimer.h"
+
+bool GpuTimer::supported_ = false;
+GpuTimer::Frame GpuTimer::frames_[GPU_TIMER_FRAMES];
+int GpuTimer::current_ = 0;
+int GpuTimer::open_scope_ = -1;
+float GpuTimer::frame_time_ = 0;
+
+void GpuTimer::setup()
+{
+	supported_ = glewIsSupported("GL_ARB_timer_query");
+
+	cout << "------------GpuTimer.cpp------------" << endl;
+	if (supported_)
+	{
+		for (auto& frame : frames_)
+		{
+			glGenQueries(GPU_TIMER_MAX_SCOPES * 2, frame.queries);
+			frame.scopes.reserve(GPU_TIMER_MAX_SCOPES);
+		}
+		cout << " - GPU pass timing enabled" << endl;
+	}
+	else
+	{
+		cout << " - GL_ARB_timer_query isn't available, GPU pass timing is disabled" << endl;
+	}
+	cout << "------------------------------------" << endl;
+}
+
+void GpuTimer::begin_frame()
+{
+	if (!supported_) return;
+
+	// the slot about to be reused was written GPU_TIMER_FRAMES frames ago
+	current_ = (current_ + 1) % GPU_TIMER_FRAMES;
+	Frame& frame = frames_[current_];
+	resolve(frame);
+
+	frame.scopes.clear();
+	frame.last_query = -1;
+	open_scope_ = -1;
+
+	// pairs the gpu's clock with the cpu's, so the gpu timeline lines up with the cpu threads in a trace
+	frame.cpu_time = ofGetElapsedTimeMicros();
+	glGetInteger64v(GL_TIMESTAMP, &frame.gpu_time);
+}
+
+void GpuTimer::resolve(Frame& frame)
+{
+	if (frame.scopes.empty() || frame.last_query < 0) return;
+
+	// queries finish in the order they were issued, so the last one being ready means they all are
+	GLint available = 0;
+	glGetQueryObjectiv(frame.queries[frame.last_query], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) return;
+
+	const bool profiling = Profiler::is_enabled();
+	float frame_time = 0;
+	for (size_t i = 0; i < frame.scopes.size(); i++)
+	{
+		Scope& scope = frame.scopes[i];
+
+		GLuint64 start = 0;
+		GLuint64 end = 0;
+		glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+		const uint32_t duration = static_cast<uint32_t>((end - start) / 1000);
+
+		if (scope.parent < 0) frame_time += duration / 1000.0f;
+
+		// scopes are stored in the order they began, so a parent is always added before its children
+		if (profiling)
+		{
+			const uint64_t cpu_start = frame.cpu_time + (static_cast<int64_t>(start) - frame.gpu_time) / 1000;
+			const uint32_t parent_path = (scope.parent < 0) ? 0 : frame.scopes[scope.parent].path;
+			scope.path = Profiler::add_timeline_scope("gpu", scope.name, parent_path, cpu_start, duration);
+		}
+	}
+	frame_time_ = frame_time;
+}
+
+int GpuTimer::begin(const char* name)
+{
+	if (!supported_) return -1;
+
+	Frame& frame = frames_[current_];
+	if (frame.scopes.size() == GPU_TIMER_MAX_SCOPES) return -1;
+
+	const int scope = static_cast<int>(frame.scopes.size());
+	frame.scopes.push_back({ name, open_scope_, 0 });
+	open_scope_ = scope;
+	glQueryCounter(frame.queries[scope * 2], GL_TIMESTAMP);
+	frame.last_query = scope * 2;
+	return scope;
+}
+
+void GpuTimer::end(const int scope)
+{
+	if (scope < 0) return;
+
+	Frame& frame = frames_[current_];
+	open_scope_ = frame.scopes[scope].parent;
+	glQueryCounter(frame.queries[scope * 2 + 1], GL_TIMESTAMP);
+	frame.last_query = scope * 2 + 1;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Profiler.h"
+
+#define GPU_TIMER_MAX_SCOPES	32	// per frame
+#define GPU_TIMER_FRAMES		2	// query sets - one is written while the other's results come back
+
+// times the gpu work issued in the rest of the enclosing block - name must be a string literal
+#define GPU_SCOPE(name) GpuScope PROFILE_CONCAT(gpu_scope_, __LINE__)(name)
+
+// gl timestamp queries around the draw passes (ARB_timer_query - core in 3.3, and exposed by mesa's llvmpipe, so it also works without a gpu)
+// a frame's queries are read back GPU_TIMER_FRAMES frames later, once they're ready, so the cpu never waits on the gpu - a frame that still isn't ready is dropped
+// results go to the perf panel and to the profiler as a "gpu" timeline (tree view and trace export)
+// render thread only, and a no-op until setup finds the extension
+class GpuTimer {
+
+public:
+
+	// once the gl context exists
+	static void setup();
+
+	// start of draw - reads back the oldest frame's results and starts a new frame in its place
+	static void begin_frame();
+
+	static bool is_supported()			{ return supported_; }
+
+	// ms, the top level scopes of the newest resolved frame added up
+	static float get_frame_time()		{ return frame_time_; }
+
+	// called by GpuScope
+	static int begin(const char* name);
+	static void end(int scope);
+
+private:
+
+	struct Scope {
+		const char* name;
+		int parent;				// -1 for top level
+		uint32_t path;			// the profiler's, set when resolved
+	};
+
+	struct Frame {
+		vector<Scope> scopes;
+		GLuint queries[GPU_TIMER_MAX_SCOPES * 2];	// start and end timestamp per scope
+		int last_query = -1;	// index of the last timestamp issued - nested scopes end after the last one began
+		uint64_t cpu_time = 0;	// microseconds, ofGetElapsedTimeMicros when the frame began
+		GLint64 gpu_time = 0;	// nanoseconds, the gpu's clock at the same moment
+	};
+
+	static void resolve(Frame& frame);
+
+	static bool supported_;
+	static Frame frames_[GPU_TIMER_FRAMES];
+	static int current_;
+	static int open_scope_;
+	static float frame_time_;
+
+};
+
+class GpuScope {
+
+public:
+
+	explicit GpuScope(const char* name)
+		:	scope_(GpuTimer::begin(name))
+	{
+	}
+
+	~GpuScope()
+	{
+		GpuTimer::end(scope_);
+	}
+
+	GpuScope(const GpuScope&) = delete;
+	GpuScope& operator=(const GpuScope&) = delete;
+
+private:
+
+	int scope_;
+
+};
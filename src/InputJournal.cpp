@@ -0,0 +1,338 @@
+#include "InputJournal.h"
+
+int InputJournal::mouse_x_ = 0;
+int InputJournal::mouse_y_ = 0;
+
+template<class T>
+static void write_value(ofstream& file, const T value)
+{
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<class T>
+static T read_value(const char*& cursor, const char* end)
+{
+	T value{};
+	if (cursor + sizeof(T) > end) return value;
+	memcpy(&value, cursor, sizeof(T));
+	cursor += sizeof(T);
+	return value;
+}
+
+bool InputJournal::start_recording(const string& path, const int64_t seed, const string& scene)
+{
+	file_.open(ofToDataPath(path), ios::binary);
+	if (!file_.is_open())
+	{
+		cout << "Error: Couldn't open input journal " << ofToDataPath(path) << " for writing" << endl;
+		return false;
+	}
+
+	seed_ = seed;
+	scene_ = scene;
+	window_width_ = ofGetWidth();
+	window_height_ = ofGetHeight();
+
+	file_.write(INPUT_JOURNAL_MAGIC, 4);
+	write_value<uint32_t>(file_, INPUT_JOURNAL_VERSION);
+	write_value<int64_t>(file_, seed_);
+	write_value<uint16_t>(file_, static_cast<uint16_t>(scene_.size()));
+	file_.write(scene_.data(), scene_.size());
+	write_value<int32_t>(file_, window_width_);
+	write_value<int32_t>(file_, window_height_);
+
+	recording_ = true;
+	start_time_ = ofGetElapsedTimeMillis();
+	last_mouse_x_ = last_mouse_y_ = 0;
+	hook_events(true);
+
+	cout << "------------InputJournal.cpp------------" << endl;
+	cout << " - Recording input to " << ofToDataPath(path) << " (seed " << seed_ << ")" << endl;
+	cout << "----------------------------------------" << endl;
+	return true;
+}
+
+bool InputJournal::load_replay(const string& path)
+{
+	const ofBuffer buffer = ofBufferFromFile(path, true);
+	const char* cursor = buffer.getData();
+	const char* end = cursor + buffer.size();
+
+	if (buffer.size() < 4 || string(cursor, 4) != INPUT_JOURNAL_MAGIC)
+	{
+		cout << "Error: " << ofToDataPath(path) << " isn't an input journal" << endl;
+		return false;
+	}
+	cursor += 4;
+	if (read_value<uint32_t>(cursor, end) != INPUT_JOURNAL_VERSION)
+	{
+		cout << "Error: " << ofToDataPath(path) << " was written by a different version" << endl;
+		return false;
+	}
+
+	seed_ = read_value<int64_t>(cursor, end);
+	const uint16_t scene_length = read_value<uint16_t>(cursor, end);
+	scene_.assign(cursor, min<size_t>(scene_length, end - cursor));
+	cursor += scene_.size();
+	window_width_ = read_value<int32_t>(cursor, end);
+	window_height_ = read_value<int32_t>(cursor, end);
+
+	int mouse_x = 0;
+	int mouse_y = 0;
+	while (cursor < end)
+	{
+		const uint8_t flags = read_value<uint8_t>(cursor, end);
+		if (flags & 1)
+		{
+			mouse_x = read_value<int16_t>(cursor, end);
+			mouse_y = read_value<int16_t>(cursor, end);
+		}
+
+		Frame frame{ mouse_x, mouse_y, {} };
+		if (flags & 2)
+		{
+			const uint16_t count = read_value<uint16_t>(cursor, end);
+			for (int i = 0; i < count; i++)
+			{
+				InputEvent event{};
+				event.type = static_cast<InputEventType>(read_value<uint8_t>(cursor, end));
+				event.time = read_value<uint32_t>(cursor, end);
+				switch (event.type)
+				{
+				case INPUT_KEY_PRESSED:
+				case INPUT_KEY_RELEASED:
+					event.key = read_value<int32_t>(cursor, end);
+					break;
+				case INPUT_MOUSE_SCROLLED:
+					event.x = read_value<int16_t>(cursor, end);
+					event.y = read_value<int16_t>(cursor, end);
+					event.scroll_x = read_value<float>(cursor, end);
+					event.scroll_y = read_value<float>(cursor, end);
+					break;
+				case INPUT_WINDOW_RESIZED:
+					event.x = read_value<int32_t>(cursor, end);
+					event.y = read_value<int32_t>(cursor, end);
+					break;
+				default:
+					event.x = read_value<int16_t>(cursor, end);
+					event.y = read_value<int16_t>(cursor, end);
+					event.key = read_value<uint8_t>(cursor, end);
+					break;
+				}
+				frame.events.push_back(event);
+			}
+		}
+		frames_.push_back(move(frame));
+	}
+
+	replaying_ = true;
+	frame_ = 0;
+	hook_events(true);
+
+	cout << "------------InputJournal.cpp------------" << endl;
+	cout << " [ Replaying Input ]" << endl;
+	cout << " - Journal: " << ofToDataPath(path) << endl;
+	cout << " - Scene: " << scene_ << ", Seed: " << seed_ << endl;
+	cout << " - Frames: " << frames_.size() << endl;
+	cout << "----------------------------------------" << endl;
+	return true;
+}
+
+bool InputJournal::begin_frame()
+{
+	if (replaying_)
+	{
+		if (frame_ >= static_cast<int>(frames_.size()))
+		{
+			replaying_ = false;
+			hook_events(recording_);
+			cout << "------------InputJournal.cpp------------" << endl;
+			cout << " - Replay finished after " << frame_ << " frames, live input from here on" << endl;
+			cout << "----------------------------------------" << endl;
+			return false;
+		}
+
+		for (auto& event : frames_[frame_].events)
+		{
+			dispatch(event);
+		}
+	}
+	return true;
+}
+
+void InputJournal::latch_mouse()
+{
+	if (replaying_)
+	{
+		const Frame& frame = frames_[frame_++];
+		mouse_x_ = frame.mouse_x;
+		mouse_y_ = frame.mouse_y;
+		return;
+	}
+
+	mouse_x_ = ofGetMouseX();
+	mouse_y_ = ofGetMouseY();
+
+	if (recording_)
+	{
+		pending_.mouse_x = mouse_x_;
+		pending_.mouse_y = mouse_y_;
+		write_frame(pending_);
+		pending_.events.clear();
+	}
+}
+
+bool InputJournal::accept(const InputEvent& event)
+{
+	if (replaying_) return dispatching_;
+
+	if (recording_ && event.type == INPUT_WINDOW_RESIZED) record(event);
+	return true;
+}
+
+void InputJournal::record(const InputEvent& event)
+{
+	pending_.events.push_back(event);
+	pending_.events.back().time = static_cast<uint32_t>(ofGetElapsedTimeMillis() - start_time_);
+}
+
+void InputJournal::write_frame(const Frame& frame)
+{
+	const bool mouse_moved = frame.mouse_x != last_mouse_x_ || frame.mouse_y != last_mouse_y_ || written_frames_ == 0;
+	const bool has_events = !frame.events.empty();
+
+	write_value<uint8_t>(file_, static_cast<uint8_t>((mouse_moved ? 1 : 0) | (has_events ? 2 : 0)));
+	if (mouse_moved)
+	{
+		write_value<int16_t>(file_, static_cast<int16_t>(frame.mouse_x));
+		write_value<int16_t>(file_, static_cast<int16_t>(frame.mouse_y));
+		last_mouse_x_ = frame.mouse_x;
+		last_mouse_y_ = frame.mouse_y;
+	}
+
+	if (has_events)
+	{
+		write_value<uint16_t>(file_, static_cast<uint16_t>(min<size_t>(frame.events.size(), 65535)));
+		for (size_t i = 0; i < min<size_t>(frame.events.size(), 65535); i++)
+		{
+			const InputEvent& event = frame.events[i];
+			write_value<uint8_t>(file_, event.type);
+			write_value<uint32_t>(file_, event.time);
+			switch (event.type)
+			{
+			case INPUT_KEY_PRESSED:
+			case INPUT_KEY_RELEASED:
+				write_value<int32_t>(file_, event.key);
+				break;
+			case INPUT_MOUSE_SCROLLED:
+				write_value<int16_t>(file_, static_cast<int16_t>(event.x));
+				write_value<int16_t>(file_, static_cast<int16_t>(event.y));
+				write_value<float>(file_, event.scroll_x);
+				write_value<float>(file_, event.scroll_y);
+				break;
+			case INPUT_WINDOW_RESIZED:
+				write_value<int32_t>(file_, event.x);
+				write_value<int32_t>(file_, event.y);
+				break;
+			default:
+				write_value<int16_t>(file_, static_cast<int16_t>(event.x));
+				write_value<int16_t>(file_, static_cast<int16_t>(event.y));
+				write_value<uint8_t>(file_, static_cast<uint8_t>(event.key));
+				break;
+			}
+		}
+	}
+
+	written_frames_++;
+}
+
+void InputJournal::dispatch(const InputEvent& event)
+{
+	// through oF, so everything listening (the app and the gui panels) sees the event as if it had come from the window
+	dispatching_ = true;
+	switch (event.type)
+	{
+	case INPUT_KEY_PRESSED:		ofNotifyKeyPressed(event.key); break;
+	case INPUT_KEY_RELEASED:	ofNotifyKeyReleased(event.key); break;
+	case INPUT_MOUSE_MOVED:		ofNotifyMouseMoved(event.x, event.y); break;
+	case INPUT_MOUSE_DRAGGED:	ofNotifyMouseDragged(event.x, event.y, event.key); break;
+	case INPUT_MOUSE_PRESSED:	ofNotifyMousePressed(event.x, event.y, event.key); break;
+	case INPUT_MOUSE_RELEASED:	ofNotifyMouseReleased(event.x, event.y, event.key); break;
+	case INPUT_MOUSE_SCROLLED:	ofNotifyMouseScrolled(event.x, event.y, event.scroll_x, event.scroll_y); break;
+	case INPUT_WINDOW_RESIZED:	ofSetWindowShape(event.x, event.y); break;
+	}
+	dispatching_ = false;
+}
+
+void InputJournal::hook_events(const bool hook)
+{
+	if (hook == hooked_) return;
+	hooked_ = hook;
+
+	// the panels register at OF_EVENT_ORDER_BEFORE_APP, this goes ahead of them
+	const int priority = OF_EVENT_ORDER_BEFORE_APP - 1;
+	if (hook)
+	{
+		ofAddListener(ofEvents().mouseMoved, this, &InputJournal::on_mouse_event, priority);
+		ofAddListener(ofEvents().mouseDragged, this, &InputJournal::on_mouse_event, priority);
+		ofAddListener(ofEvents().mousePressed, this, &InputJournal::on_mouse_event, priority);
+		ofAddListener(ofEvents().mouseReleased, this, &InputJournal::on_mouse_event, priority);
+		ofAddListener(ofEvents().mouseScrolled, this, &InputJournal::on_mouse_event, priority);
+		ofAddListener(ofEvents().keyPressed, this, &InputJournal::on_key_event, priority);
+		ofAddListener(ofEvents().keyReleased, this, &InputJournal::on_key_event, priority);
+	}
+	else
+	{
+		ofRemoveListener(ofEvents().mouseMoved, this, &InputJournal::on_mouse_event, priority);
+		ofRemoveListener(ofEvents().mouseDragged, this, &InputJournal::on_mouse_event, priority);
+		ofRemoveListener(ofEvents().mousePressed, this, &InputJournal::on_mouse_event, priority);
+		ofRemoveListener(ofEvents().mouseReleased, this, &InputJournal::on_mouse_event, priority);
+		ofRemoveListener(ofEvents().mouseScrolled, this, &InputJournal::on_mouse_event, priority);
+		ofRemoveListener(ofEvents().keyPressed, this, &InputJournal::on_key_event, priority);
+		ofRemoveListener(ofEvents().keyReleased, this, &InputJournal::on_key_event, priority);
+	}
+}
+
+bool InputJournal::on_mouse_event(ofMouseEventArgs& args)
+{
+	const int x = static_cast<int>(args.x);
+	const int y = static_cast<int>(args.y);
+	switch (args.type)
+	{
+	case ofMouseEventArgs::Moved:		return hooked_event({ INPUT_MOUSE_MOVED, 0, 0, x, y, 0, 0 });
+	case ofMouseEventArgs::Dragged:		return hooked_event({ INPUT_MOUSE_DRAGGED, 0, args.button, x, y, 0, 0 });
+	case ofMouseEventArgs::Pressed:		return hooked_event({ INPUT_MOUSE_PRESSED, 0, args.button, x, y, 0, 0 });
+	case ofMouseEventArgs::Released:	return hooked_event({ INPUT_MOUSE_RELEASED, 0, args.button, x, y, 0, 0 });
+	case ofMouseEventArgs::Scrolled:	return hooked_event({ INPUT_MOUSE_SCROLLED, 0, 0, x, y, args.scrollX, args.scrollY });
+	default:							return false;
+	}
+}
+
+bool InputJournal::on_key_event(ofKeyEventArgs& args)
+{
+	const InputEventType type = (args.type == ofKeyEventArgs::Pressed) ? INPUT_KEY_PRESSED : INPUT_KEY_RELEASED;
+	return hooked_event({ type, 0, args.key, 0, 0, 0, 0 });
+}
+
+bool InputJournal::hooked_event(const InputEvent& event)
+{
+	// replayed events pass through to the panels and the app, live ones stop here
+	if (replaying_) return !dispatching_;
+
+	// everything is recorded before the panels get a chance to consume it
+	if (recording_) record(event);
+	return false;
+}
+
+void InputJournal::finish()
+{
+	hook_events(false);
+	if (!recording_) return;
+
+	recording_ = false;
+	file_.close();
+
+	cout << "------------InputJournal.cpp------------" << endl;
+	cout << " - Input journal saved, " << written_frames_ << " frames" << endl;
+	cout << "----------------------------------------" << endl;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <fstream>
+
+#include "ofMain.h"
+
+#define INPUT_JOURNAL_MAGIC		"IOTJ"
+#define INPUT_JOURNAL_VERSION	1
+
+enum InputEventType : uint8_t {
+	INPUT_KEY_PRESSED,
+	INPUT_KEY_RELEASED,
+	INPUT_MOUSE_MOVED,
+	INPUT_MOUSE_DRAGGED,
+	INPUT_MOUSE_PRESSED,
+	INPUT_MOUSE_RELEASED,
+	INPUT_MOUSE_SCROLLED,
+	INPUT_WINDOW_RESIZED
+};
+
+struct InputEvent {
+	InputEventType type;
+	uint32_t time;		// ms since the journal started
+	int key;			// key, mouse button
+	int x;				// mouse position, window size
+	int y;
+	float scroll_x;
+	float scroll_y;
+};
+
+// journal of a session's input - the events each frame saw and the mouse position the frame was simulated with
+// events are handled where oF delivers them, just before update, and replayed from the same place, so a replay feeds the app exactly what it saw live
+// mouse and key events are recorded by listeners ahead of the gui panels (which listen to ofEvents() themselves and consume what lands on them), so slider and toggle changes are journaled too
+// replayed events go back through oF's notify functions, so the panels get them as well - live input is swallowed by the same listeners until the replay ends
+// the mouse is latched once per frame and handed to the simulation in its StepInput, rather than the simulation polling oF (which also changed under the simulation thread)
+//
+// file: header (magic, version, seed, scene, window size), then per frame one flags byte - bit 0 mouse moved (2 x int16 follow),
+// bit 1 events (uint16 count, then per event: type, uint32 ms, and the fields that type uses)
+class InputJournal {
+
+public:
+
+	// the header's seed and scene start the replay the way the recording started
+	bool start_recording(const string& path, int64_t seed, const string& scene);
+	bool load_replay(const string& path);
+
+	// main thread, at the start of update and before the simulation lock (the handlers take it) - a replay dispatches the frame's events
+	// returns false once a replay has run out of frames
+	bool begin_frame();
+
+	// with the simulation lock held, so the simulation thread never sees it change mid step - recording writes the frame out here
+	void latch_mouse();
+
+	// handlers call this first - false means drop the event (live input during a replay)
+	// mouse and key events were already recorded ahead of the panels, only the window's are recorded here
+	bool accept(const InputEvent& event);
+
+	void finish();
+
+	bool is_recording() const				{ return recording_; }
+	bool is_replaying() const				{ return replaying_; }
+
+	int64_t get_seed() const				{ return seed_; }
+	const string& get_scene() const			{ return scene_; }
+	int get_frame_count() const				{ return static_cast<int>(frames_.size()); }
+	int get_window_width() const			{ return window_width_; }
+	int get_window_height() const			{ return window_height_; }
+
+	// the mouse position the current frame is simulated with
+	static int get_mouse_x()				{ return mouse_x_; }
+	static int get_mouse_y()				{ return mouse_y_; }
+
+private:
+
+	struct Frame {
+		int mouse_x;
+		int mouse_y;
+		vector<InputEvent> events;
+	};
+
+	void record(const InputEvent& event);
+	void write_frame(const Frame& frame);
+	void dispatch(const InputEvent& event);
+
+	// while recording or replaying, ahead of every other mouse and key listener - records the event, or, replaying, returns true to stop a live one there
+	void hook_events(bool hook);
+	bool on_mouse_event(ofMouseEventArgs& args);
+	bool on_key_event(ofKeyEventArgs& args);
+	bool hooked_event(const InputEvent& event);
+
+	bool recording_ = false;
+	bool replaying_ = false;
+	bool dispatching_ = false;
+	bool hooked_ = false;
+
+	int64_t seed_ = -1;
+	string scene_;
+	int window_width_ = 0;
+	int window_height_ = 0;
+	uint64_t start_time_ = 0;	// ms
+
+	ofstream file_;
+	Frame pending_;			// recording - what's arrived since the last frame
+	int written_frames_ = 0;
+	int last_mouse_x_ = 0;
+	int last_mouse_y_ = 0;
+
+	vector<Frame> frames_;	// replay
+	int frame_ = 0;
+
+	static int mouse_x_;
+	static int mouse_y_;
+
+};
@@ -1,68 +1,584 @@
 #include "Iota.h"
 
-void Iota::setup(ofBaseApp* app_ptr)
+#include "BatchEvaluator.h"
+#include "Microbench.h"
+
+void Iota::setup(ofBaseApp* app_ptr, const RunOptions& run_options)
 {
-	ofSetWindowTitle("iota");
-	ofSetCircleResolution(176);
-	ofBackground(0);
-	ofSetVerticalSync(true);
-	ofEnableAlphaBlending();
-	ofSetBackgroundAuto(true);
-	ofSetEscapeQuitsApp(false);
-	window_resized(ofGetWidth(), ofGetHeight());
+	RunOptions options = run_options;
+	headless_ = options.headless;
+	Profiler::set_thread_name("main");
+
+	update_allocation_tag_ = AllocationTracker::register_tag("update");
+	draw_allocation_tag_ = AllocationTracker::register_tag("draw");
+	audio_allocation_tag_ = AllocationTracker::register_tag("audio out");
+	AllocationTracker::set_strict(options.strict_allocations);
+
+	trace_first_frame_ = options.trace_first_frame;
+	trace_frame_count_ = options.trace_frame_count;
+	trace_output_ = options.trace_output;
+
+	// a replay starts the way its recording did
+	if (!options.replay_path.empty() && input_journal.load_replay(options.replay_path))
+	{
+		options.seed = static_cast<int>(input_journal.get_seed());
+		options.scene = input_journal.get_scene();
+		options.frames = input_journal.get_frame_count();
+		if (!headless_) ofSetWindowShape(input_journal.get_window_width(), input_journal.get_window_height());
+	}
+	else if (!options.record_path.empty())
+	{
+		// a recording is only reproducible from its seed
+		if (options.seed < 0) options.seed = static_cast<int>(ofGetSystemTimeMicros() % 1000000000);
+		input_journal.start_recording(options.record_path, options.seed, options.scene);
+	}
+
+	if (!headless_)
+	{
+		ofSetWindowTitle("iota");
+		ofBackground(0);
+		ofSetVerticalSync(true);
+		ofEnableAlphaBlending();
+		ofSetBackgroundAuto(true);
+		ofSetEscapeQuitsApp(false);
+		window_resized(ofGetWidth(), ofGetHeight());
+		GpuTimer::setup();
+	}
+
+	// the workers start first so the samples and the scene file decode while the main thread sets up the rest
+	job_system.start(options.threads);
+	asset_manager.begin(&job_system);
+	asset_manager.load_async("scene " + ofFilePath::getFileName(options.scene), [this, &options] { scene_manager.preload_scene(options.scene); });
 
 	event_manager.init(&entity_manager, &gui_manager, &gamemode_manager);
 	gamemode_manager.init(&gui_manager);
 	scene_manager.init(&game_controller, &gui_manager, &cam, &fluid_manager, &audio_manager, &entity_manager, &gamemode_manager);
-	entity_manager.init(&game_controller, &gui_manager, &cam, &fluid_manager, &audio_manager, &gamemode_manager);
-	fluid_manager.init(&gui_manager);	
-	audio_manager.setup(app_ptr);
-	gui_manager.init(&game_controller, &audio_manager, &cam);
+	entity_manager.init(&game_controller, &gui_manager, &cam, &fluid_manager, &audio_manager, &gamemode_manager, &step_input, &job_system);
+	asset_manager.load("fluid", [this] { fluid_manager.init(&gui_manager, &cam, headless_); });
+	asset_manager.load("audio setup", [this] { audio_manager.setup(asset_manager); });
+	asset_manager.load("gui", [this] { gui_manager.init(&game_controller, &audio_manager, &cam); });
+	gui_manager.gui_perf_spike_threshold = options.spike_threshold;
+
+	if (!headless_)
+	{
+		gui_manager.load_fonts(asset_manager);
+		gamemode_manager.load_fonts(asset_manager);
+	}
+
+	// frames are only recorded (and marks only collected) by the windowed update
+	FlightRecorder::set_enabled(!headless_);
+
+	// the stream only opens once every sample has decoded
+	asset_manager.wait();
+	audio_manager.soundSetup(app_ptr, !headless_);
+
+	// without a seed every run is different, with one a scene plays out the same every time
+	if (options.seed >= 0)
+	{
+		ofSeedRandom(options.seed);
+		Random::seed(options.seed);
+	}
+	else
+	{
+		Random::seed(ofGetSystemTimeMicros());
+	}
 	
-	scene_manager.load_scene("Scenes/menu_scene.xml");
+	scene_manager.load_scene(options.scene);
+	asset_manager.report();
+
+	build_task_graphs();
+
+	if (options.microbench)
+	{
+		// runs on the first update, once the app is fully set up
+		microbenchmarking_ = true;
+		return;
+	}
+
+	if (options.batch_eval_count > 0)
+	{
+		// runs on the first update, like the microbenchmarks
+		batch_eval_count_ = options.batch_eval_count;
+		batch_eval_output_ = options.batch_eval_output;
+		batch_eval_seed_ = options.seed;
+		batch_eval_threads_ = options.threads;
+		headless_frames_ = options.frames;
+		return;
+	}
+
+	if (options.benchmark)
+	{
+		ofSetFrameRate(0);
+		benchmarking_ = true;
+		entity_manager.set_time_springs(true);
+		benchmark_seed_ = options.seed;
+		benchmark_output_ = options.benchmark_output;
+		headless_frames_ = options.frames;
+
+		find_benchmark_scenes();
+		benchmark_.begin_run(headless_frames_, benchmark_seed_, job_system.get_worker_count());
+		start_benchmark_scene();
+		return;
+	}
+
+	if (headless_)
+	{
+		// the simulation advances a fixed amount per step, so an unthrottled loop runs faster than real time
+		ofSetFrameRate(0);
+		headless_frames_ = options.frames;
+		headless_start_ = ofGetElapsedTimeMicros();
+
+		cout << "------------Iota.cpp------------" << endl;
+		cout << " [ Headless Run ]" << endl;
+		cout << " - Scene: " << options.scene << endl;
+		cout << " - Frames: " << headless_frames_ << endl;
+		cout << " - Seed: " << ((options.seed >= 0) ? ofToString(options.seed) : "none") << endl;
+		cout << "--------------------------------" << endl;
+		return;
+	}
+
+	simulation_thread.setup([this](RenderSnapshot& snapshot) { simulate(snapshot); });
+	simulation_thread.start();
+}
+
+void Iota::exit()
+{
+	Profiler::stop_capture();
+	input_journal.finish();
+	simulation_thread.stop();
+	job_system.stop();
+}
+
+void Iota::build_task_graphs()
+{
+	// each manager's per-frame work with what it reads and writes, anything that doesn't overlap runs in parallel
+
+	// main thread, after events/gamemode/scene (those can open dialogs and load scenes, so they stay in order on the main thread)
+	update_graph_.add_task("audio", [this] { if (const GameObject* player = entity_manager.get_player()) audio_manager.update(player->get_position()); }, { "entities" }, { "audio" });
+	update_graph_.add_task("gui", [this] { gui_manager.update(); }, {}, { "gui" });
+	update_graph_.add_task("camera", [this] { cam.update(entity_manager.get_player_position(), step_input); }, { "entities" }, { "camera" });
+	update_graph_.add_task("render scale", [this]
+	{
+		// world pass resolution for this frame, lowered when frames run long
+		render_scale_governor.set_enabled(gui_manager.gui_perf_dynamic_resolution);
+		render_scale_governor.update(ofGetLastFrameTime());
+		gui_manager.update_render_scale_values(render_scale_governor.get_render_scale(), render_scale_governor.get_average_frame_time());
+		cam.set_render_scale(render_scale_governor.get_render_scale());
+	}, {}, { "render scale", "gui", "camera" });
+
+	// simulation thread - entities push into the fluid (and spawn particles), so the solver steps after them
+	simulation_graph_.add_task("entities", [this] { entity_manager.update(); }, { "camera", "gamemode" }, { "entities", "fluid", "particles", "gui", "audio" });
+	simulation_graph_.add_task("fluid", [this] { fluid_manager.update(); }, { "gui" }, { "fluid" });
+	if (!headless_)
+	{
+		// nothing is drawn headless, so the render snapshots are never built
+		simulation_graph_.add_task("entity snapshot", [this]
+		{
+			simulation_snapshot_->frame = ofGetFrameNum();
+			entity_manager.record_game_objects(simulation_snapshot_->entities, cam.get_visible_world_rect(32), cam.get_world_units_per_pixel());
+		}, { "entities", "camera", "gamemode", "gui" }, { "entity snapshot" });
+		simulation_graph_.add_task("fluid image", [this] { fluid_manager.update_fluid_snapshot(simulation_snapshot_->fluid); }, { "fluid", "gui" }, { "fluid snapshot" });
+	}
+	simulation_graph_.add_task("particles", [this]
+	{
+		fluid_manager.update_particle_snapshot(entity_manager.get_player(), cam.get_visible_world_rect(16), cam.get_world_units_per_pixel(), simulation_snapshot_->particles);
+	}, { "fluid", "entities", "camera", "gui" }, { "particles", "particle snapshot" });
 }
 
 void Iota::audio_out(float* output, const int buffer_size, const int n_channels)
 {
+	// the sound device's thread
+	static thread_local bool thread_named = false;
+	if (!thread_named)
+	{
+		Profiler::set_thread_name("audio");
+		thread_named = true;
+	}
+
+	PROFILE_SCOPE("audio out");
+	AllocationScope allocation_scope(audio_allocation_tag_);
 	audio_manager.audioOut(output, buffer_size, n_channels);
 }
 
 void Iota::update()
 {
+	if (headless_)
+	{
+		step_headless();
+		return;
+	}
+
+	// scopes are only recorded while the profiler view is open or a trace is being captured
+	update_trace_capture();
+	Profiler::set_enabled(gui_manager.gui_perf_show_profiler);
+	if (Profiler::is_enabled()) Profiler::collect(ofGetLastFrameTime() * 1000.0f);
+
+	PROFILE_SCOPE("update");
+	const uint64_t update_start = ofGetElapsedTimeMicros();
+
+	// replayed events take the simulation lock themselves, so they're dispatched before it's held
+	input_journal.begin_frame();
+
+	unique_lock<mutex> lock(simulation_thread.get_simulation_mutex(), defer_lock);
+	{
+		// waits for the previous simulation step to finish
+		PROFILE_SCOPE("wait for simulation");
+		lock.lock();
+	}
+	record_frame(update_time_, (ofGetElapsedTimeMicros() - update_start) / 1000.0f);
+	latch_step_input();
+
+	// nothing else is running here, the simulation step has finished and the next one hasn't been requested
+	FrameArena::next_frame();
+	AllocationTracker::end_frame();
+	AllocationScope allocation_scope(update_allocation_tag_);
+
+	// buttons pressed since the last step, scenes and entities pick the requests up below and on the simulation thread
+	gui_manager.apply_commands();
+	event_manager.update();
+	gamemode_manager.update();
+	{
+		PROFILE_SCOPE("scene");
+		scene_manager.update();
+	}
+	update_graph_.run(job_system);
+
+	lock.unlock();
+
+	// entities, fluid and particles step on the simulation thread while this frame is drawn
+	simulation_thread.request_step();
+	update_time_ = (ofGetElapsedTimeMicros() - update_start) / 1000.0f;
+}
+
+void Iota::record_frame(const float update_ms, const float wait_ms)
+{
+	if (ofGetFrameNum() == 0) return;
+
+	FrameRecord record;
+	record.frame = ofGetFrameNum() - 1;
+	record.time = ofGetElapsedTimef();
+	record.frame_ms = ofGetLastFrameTime() * 1000.0f;
+	record.update_ms = update_ms;
+	record.wait_ms = wait_ms;
+	record.draw_ms = draw_time_;
+	record.simulation_ms = simulation_thread.get_step_time();
+	record.entities_ms = simulation_graph_.get_task_time("entities");
+	record.collisions_ms = entity_manager.get_compute_time();
+	record.springs_ms = entity_manager.get_spring_time();
+	record.fluid_ms = simulation_graph_.get_task_time("fluid");
+	record.particles_ms = simulation_graph_.get_task_time("particles");
+	record.entity_count = static_cast<int>(entity_manager.get_game_objects()->size());
+	record.particle_count = fluid_manager.get_particle_system()->get_live_count();
+	flight_recorder.record(record, gui_manager.gui_perf_spike_threshold);
+}
+
+void Iota::latch_step_input()
+{
+	input_journal.latch_mouse();
+
+	step_input.frame = ofGetFrameNum();
+	step_input.mouse_x = InputJournal::get_mouse_x();
+	step_input.mouse_y = InputJournal::get_mouse_y();
+	step_input.window_width = ofGetWidth();
+	step_input.window_height = ofGetHeight();
+}
+
+void Iota::update_trace_capture()
+{
+	if (trace_first_frame_ < 0) return;
+
+	const int frame = static_cast<int>(ofGetFrameNum());
+	if (frame == trace_first_frame_)
+	{
+		Profiler::start_capture(trace_output_);
+	}
+	else if (frame == trace_first_frame_ + trace_frame_count_)
+	{
+		Profiler::stop_capture();
+		trace_first_frame_ = -1;
+	}
+}
+
+void Iota::simulate(RenderSnapshot& snapshot)
+{
+	PROFILE_SCOPE("simulation step");
+	simulation_snapshot_ = &snapshot;
+	simulation_graph_.run(job_system);
+	simulation_snapshot_ = nullptr;
+}
+
+void Iota::step_headless()
+{
+	if (headless_finished_) return;
+
+	update_trace_capture();
+	if (Profiler::is_enabled()) Profiler::collect(ofGetLastFrameTime() * 1000.0f);
+	PROFILE_SCOPE("step");
+
+	FrameArena::next_frame();
+	AllocationTracker::end_frame();
+	AllocationScope allocation_scope(update_allocation_tag_);
+
+	if (microbenchmarking_)
+	{
+		Microbench(*this).run();
+		headless_finished_ = true;
+		ofExit(0);
+		return;
+	}
+
+	if (batch_eval_count_ > 0)
+	{
+		BatchEvaluator evaluator(batch_eval_count_, headless_frames_, batch_eval_seed_, batch_eval_threads_);
+		evaluator.run();
+		evaluator.save(batch_eval_output_);
+		headless_finished_ = true;
+		ofExit(0);
+		return;
+	}
+
+	if (benchmarking_) script_benchmark_input();
+
+	if (!input_journal.begin_frame())
+	{
+		// the replay has run out of input
+		finish_headless();
+		headless_finished_ = true;
+		ofExit(0);
+		return;
+	}
+	latch_step_input();
+
+	gui_manager.apply_commands();
 	event_manager.update();
 	gamemode_manager.update();
 	scene_manager.update();
-	entity_manager.update();
-	fluid_manager.update();
-	audio_manager.update(entity_manager.get_player()->get_position());
-	gui_manager.update();
-	cam.update(entity_manager.get_player_position());
+	update_graph_.run(job_system);
+
+	simulate(headless_snapshot_);
+
+	// audio normally runs on the sound device's thread - here one frame's worth of samples is synthesised per step
+	const int samples = audio_manager.sampleRate / 60;
+	headless_audio_buffer_.resize(samples * 2);
+	const uint64_t audio_start = ofGetElapsedTimeMicros();
+	audio_manager.audioOut(headless_audio_buffer_.data(), samples, 2);
+	const float audio_time = (ofGetElapsedTimeMicros() - audio_start) / 1000.0f;
+
+	headless_frame_++;
+	if (benchmarking_)
+	{
+		record_benchmark_step(audio_time);
+	}
+	else if (headless_frame_ >= headless_frames_)
+	{
+		finish_headless();
+		headless_finished_ = true;
+		ofExit(0);
+	}
+}
+
+void Iota::finish_headless() const
+{
+	const float seconds = max((ofGetElapsedTimeMicros() - headless_start_) / 1000000.0f, 0.000001f);
+
+	cout << "------------Iota.cpp------------" << endl;
+	cout << " [ Headless Run Finished ]" << endl;
+	cout << " - Frames: " << headless_frame_ << endl;
+	cout << " - Time: " << ofToString(seconds, 3) << "s" << endl;
+	cout << " - Frames per second: " << ofToString(headless_frame_ / seconds, 1) << endl;
+	cout << " - Real time factor: " << ofToString(headless_frame_ / 60.0f / seconds, 2) << "x" << endl;
+	cout << " - Allocations per frame: " << ofToString(AllocationTracker::get_total_count() / static_cast<double>(max<uint64_t>(AllocationTracker::get_frames(), 1)), 1) << endl;
+	cout << "--------------------------------" << endl;
+}
+
+void Iota::find_benchmark_scenes()
+{
+	ofDirectory scenes("Scenes");
+	scenes.allowExt("xml");
+	scenes.listDir();
+	scenes.sort();
+	for (size_t i = 0; i < scenes.size(); i++)
+	{
+		benchmark_scenes_.push_back({ ofFilePath::getBaseName(scenes.getName(i)), scenes.getPath(i), 0 });
+	}
+
+	benchmark_scenes_.push_back({ "stress_250", "", 250 });
+	benchmark_scenes_.push_back({ "stress_1000", "", 1000 });
+}
+
+void Iota::start_benchmark_scene()
+{
+	const BenchmarkScene& scene = benchmark_scenes_[benchmark_scene_];
+
+	// every scene starts from the same seed, so a scene's run doesn't depend on the ones before it
+	ofSeedRandom(benchmark_seed_);
+	Random::seed(benchmark_seed_);
+
+	if (scene.stress_count > 0)
+	{
+		scene_manager.load_scene("Scenes/blank_scene.xml");
+		spawn_stress_entities(scene.stress_count);
+	}
+	else
+	{
+		scene_manager.load_scene(scene.path);
+	}
+
+	// sandbox has full input, so the scripted mouse reaches the player
+	gamemode_manager.set_current_mode_id(0);
+
+	headless_frame_ = 0;
+	benchmark_.begin_scene(scene.name, static_cast<int>(entity_manager.get_game_objects()->size()));
+}
+
+void Iota::spawn_stress_entities(const int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		RandomStream& random = Random::get(RANDOM_SCENE);
+		const float x = random.range(-world::HALF_WORLD_WIDTH, world::HALF_WORLD_WIDTH);
+		const float y = random.range(-world::HALF_WORLD_HEIGHT, world::HALF_WORLD_HEIGHT);
+		const ofVec2f pos(x, y);
+		const float type = random.next_float();
+		if (type < 0.8f)
+		{
+			entity_manager.create_entity("Mass", pos);
+		}
+		else if (type < 0.9f)
+		{
+			entity_manager.create_entity("Spring", pos);
+		}
+		else
+		{
+			entity_manager.create_entity("Collectable", pos);
+		}
+	}
+}
+
+void Iota::script_benchmark_input() const
+{
+	// the mouse circles the middle of the window - held down for three seconds, then released for one
+	const int cycle = headless_frame_ % 240;
+	const float angle = headless_frame_ * TWO_PI / 240;
+	const int x = static_cast<int>(ofGetWidth() / 2 + cos(angle) * 300);
+	const int y = static_cast<int>(ofGetHeight() / 2 + sin(angle) * 300);
+
+	// goes through the window events, so it takes the same path as real input
+	if (cycle == 0)
+	{
+		ofNotifyMousePressed(x, y, 0);
+	}
+	else if (cycle < 180)
+	{
+		ofNotifyMouseDragged(x, y, 0);
+	}
+	else if (cycle == 180)
+	{
+		ofNotifyMouseReleased(x, y, 0);
+	}
+	else
+	{
+		ofNotifyMouseMoved(x, y);
+	}
+}
+
+void Iota::record_benchmark_step(const float audio_time)
+{
+	// collisions and springs are parts of the entity step, reported on their own as well
+	benchmark_.add_sample("entities", simulation_graph_.get_task_time("entities"));
+	benchmark_.add_sample("collisions", entity_manager.get_compute_time());
+	benchmark_.add_sample("springs", entity_manager.get_spring_time());
+	benchmark_.add_sample("fluid", simulation_graph_.get_task_time("fluid"));
+	benchmark_.add_sample("particles", simulation_graph_.get_task_time("particles"));
+	benchmark_.add_sample("audio dsp", audio_time);
+
+	if (headless_frame_ < headless_frames_) return;
+
+	benchmark_.end_scene();
+	benchmark_scene_++;
+	if (benchmark_scene_ < static_cast<int>(benchmark_scenes_.size()))
+	{
+		start_benchmark_scene();
+		return;
+	}
+
+	benchmark_.save(benchmark_output_);
+	headless_finished_ = true;
+	ofExit(0);
 }
 
 void Iota::draw()
-{	
+{
+	if (headless_) return;
+
+	PROFILE_SCOPE("draw");
+	const uint64_t draw_start = ofGetElapsedTimeMicros();
+	GpuTimer::begin_frame();
+	AllocationScope allocation_scope(draw_allocation_tag_);
+
+	// the world is drawn from the newest published snapshot, never from live simulation state
+	simulation_thread.update_snapshot();
+	const RenderSnapshot& snapshot = simulation_thread.get_snapshot();
+
+	// world pass, rendered offscreen at a reduced resolution when frames run long
+	render_scale_governor.begin();
 	cam.begin();
 
 	// draw fluid and particle systemS
-	fluid_manager.draw(entity_manager.get_player());
+	fluid_manager.draw(snapshot, simulation_thread.get_simulation_mutex());
 	
 	// draw all entities
-	ofPushMatrix();
-	ofTranslate(HALF_WORLD_WIDTH, HALF_WORLD_HEIGHT);
-	entity_manager.draw_game_objects();
-	ofPopMatrix();
+	{
+		PROFILE_SCOPE("entities");
+		GPU_SCOPE("entities");
+		ofPushMatrix();
+		ofTranslate(world::HALF_WORLD_WIDTH, world::HALF_WORLD_HEIGHT);
+		entity_manager.draw_game_objects(snapshot.entities);
+		ofPopMatrix();
+	}
 
 	// gamemode menu + transitions
 	gamemode_manager.draw();
 
 	cam.end();
+	render_scale_governor.end();
+	render_scale_governor.draw();
 
-	// gui
+	// gui - panels are written to by the simulation step
+	PROFILE_SCOPE("gui");
+	GPU_SCOPE("gui");
+	lock_guard<mutex> lock(simulation_thread.get_simulation_mutex());
 	gui_manager.draw_required_gui(entity_manager.get_selected_game_object(), entity_manager.get_new_node_type(), gamemode_manager.get_current_mode_string(), gamemode_manager.get_main_mode_started(), gamemode_manager.get_prev_gamemode());
+
+	if (gui_manager.gui_perf_show_profiler)
+	{
+		// next to the perf panel
+		const ofRectangle& panel = gui_manager.panel_perf.getShape();
+		Profiler::draw(panel.getRight() + 10, panel.getTop() + 10);
+	}
+
+	if (gui_manager.gui_perf_show_allocations)
+	{
+		// under the perf panel
+		const ofRectangle& panel = gui_manager.panel_perf.getShape();
+		AllocationTracker::draw(panel.getLeft(), panel.getBottom() + 20);
+	}
+
+	if (gui_manager.gui_perf_show_task_graph)
+	{
+		update_graph_.draw_debug(ofGetWidth() - 520, ofGetHeight() - 220);
+		simulation_graph_.draw_debug(ofGetWidth() - 520, ofGetHeight() - 130);
+	}
+
+	draw_time_ = (ofGetElapsedTimeMicros() - draw_start) / 1000.0f;
+	asset_manager.first_frame_drawn();
 }
 
 void Iota::key_pressed(const int key)
 {
+	if (!input_journal.accept({ INPUT_KEY_PRESSED, 0, key, 0, 0, 0, 0 })) return;
+	lock_guard<mutex> lock(simulation_thread.get_simulation_mutex());
+
 	gamemode_manager.key_pressed(key);
 	
 	if (event_manager.is_event_allowed("key_pressed")) {
@@ -79,10 +595,18 @@ void Iota::key_pressed(const int key)
 	{
 		ofToggleFullscreen();
 	}
+	else if (key == 57353) // f10
+	{
+		if (Profiler::is_capturing()) Profiler::stop_capture();
+		else Profiler::start_capture("trace_" + ofGetTimestampString() + ".json");
+	}
 }
 
 void Iota::key_released(const int key)
 {
+	if (!input_journal.accept({ INPUT_KEY_RELEASED, 0, key, 0, 0, 0, 0 })) return;
+	lock_guard<mutex> lock(simulation_thread.get_simulation_mutex());
+
 	if (event_manager.is_event_allowed("key_released")) {
 		entity_manager.key_released(key);
 		audio_manager.keyReleased(key);
@@ -93,10 +617,14 @@ void Iota::key_released(const int key)
 
 void Iota::mouse_moved(const int x, const int y)
 {
+	input_journal.accept({ INPUT_MOUSE_MOVED, 0, 0, x, y, 0, 0 });
 }
 
 void Iota::mouse_dragged(const int x, const int y, const int button)
 {
+	if (!input_journal.accept({ INPUT_MOUSE_DRAGGED, 0, button, x, y, 0, 0 })) return;
+	lock_guard<mutex> lock(simulation_thread.get_simulation_mutex());
+
 	if (event_manager.is_event_allowed("mouse_dragged", button)) {
 		entity_manager.mouse_dragged(x, y, button);
 		cam.mouse_dragged(x, y, button);
@@ -105,6 +633,9 @@ void Iota::mouse_dragged(const int x, const int y, const int button)
 
 void Iota::mouse_pressed(const int x, const int y, const int button)
 {
+	if (!input_journal.accept({ INPUT_MOUSE_PRESSED, 0, button, x, y, 0, 0 })) return;
+	lock_guard<mutex> lock(simulation_thread.get_simulation_mutex());
+
 	gamemode_manager.mouse_pressed(x, y, button);
 	
 	if (event_manager.is_event_allowed("mouse_pressed", button)) {
@@ -116,6 +647,9 @@ void Iota::mouse_pressed(const int x, const int y, const int button)
 
 void Iota::mouse_scrolled(const int x, const int y, const float scroll_x, const float scroll_y)
 {
+	if (!input_journal.accept({ INPUT_MOUSE_SCROLLED, 0, 0, x, y, scroll_x, scroll_y })) return;
+	lock_guard<mutex> lock(simulation_thread.get_simulation_mutex());
+
 	if (event_manager.is_event_allowed("mouse_scrolled")) {
 		cam.mouse_scrolled(x, y, scroll_x, scroll_y);
 	}
@@ -123,6 +657,9 @@ void Iota::mouse_scrolled(const int x, const int y, const float scroll_x, const
 
 void Iota::mouse_released(const int x, const int y, const int button)
 {
+	if (!input_journal.accept({ INPUT_MOUSE_RELEASED, 0, button, x, y, 0, 0 })) return;
+	lock_guard<mutex> lock(simulation_thread.get_simulation_mutex());
+
 	if (event_manager.is_event_allowed("mouse_released", button)) {
 		entity_manager.mouse_released(x, y, button);
 		cam.mouse_released(x, y, button);
@@ -140,6 +677,8 @@ void Iota::mouse_exited(int x, int y)
 
 void Iota::window_resized(int w, int h)
 {
+	// always handled - a replay's resizes come back through here from ofSetWindowShape
+	input_journal.accept({ INPUT_WINDOW_RESIZED, 0, 0, w, h, 0, 0 });
 	gui_manager.window_resized();
 }
 
@@ -1,20 +1,35 @@
 #pragma once
 
+#include "AllocationTracker.h"
+#include "AssetManager.h"
 #include "AudioManager.h"
+#include "Benchmark.h"
 #include "Camera.h"
 #include "Controller.h"
 #include "EntityManager.h"
 #include "EventManager.h"
+#include "FlightRecorder.h"
 #include "FluidManager.h"
+#include "core/FrameArena.h"
 #include "GamemodeManager.h"
+#include "GpuTimer.h"
 #include "GUIManager.h"
+#include "InputJournal.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "core/Random.h"
+#include "core/StepInput.h"
+#include "RenderScaleGovernor.h"
+#include "RunOptions.h"
 #include "SceneManager.h"
+#include "SimulationThread.h"
+#include "TaskGraph.h"
 
 class Iota
 {
 public:
 
-	void setup(ofBaseApp* app_ptr);
+	void setup(ofBaseApp* app_ptr, const RunOptions& options = RunOptions());
 
 	void audio_out(float* output, int buffer_size, int n_channels);
 
@@ -22,6 +37,8 @@ public:
 
 	void draw();
 
+	void exit();
+
 	void key_pressed(int key);
 	void key_released(int key);
 	void mouse_moved(int x, int y);
@@ -42,7 +59,84 @@ public:
 	GamemodeManager gamemode_manager{ 2 }; // main menu
 	EventManager event_manager;
 	AudioManager audio_manager;
+	AssetManager asset_manager;
 	FluidManager fluid_manager;
 	Camera cam;
+	RenderScaleGovernor render_scale_governor;
+	JobSystem job_system;
+	FlightRecorder flight_recorder;
+	InputJournal input_journal;
+	StepInput step_input; // what the simulation step reads from outside the world, latched each frame
+	SimulationThread simulation_thread; // declared last, so it's stopped before anything it steps is destroyed
+
+private:
+
+	void build_task_graphs();
+
+	// starts/stops the --trace capture on its frame range
+	void update_trace_capture();
+
+	// the previous frame, once its simulation step has finished
+	void record_frame(float update_ms, float wait_ms);
+
+	// with the simulation lock held - the mouse, window size and frame number the next step runs with
+	void latch_step_input();
+
+	// runs on the simulation thread
+	void simulate(RenderSnapshot& snapshot);
+
+	// headless - update and simulation run back to back on the main thread, as fast as they can
+	void step_headless();
+	void finish_headless() const;
+
+	// benchmark - every scene in Scenes/ plus generated stress scenes, each stepped headless_frames_ times with scripted input
+	void find_benchmark_scenes();
+	void start_benchmark_scene();
+	void spawn_stress_entities(int count);
+	void script_benchmark_input() const;
+	void record_benchmark_step(float audio_time);
+
+	TaskGraph update_graph_{ "update" };
+	TaskGraph simulation_graph_{ "simulation" };
+	RenderSnapshot* simulation_snapshot_{}; // snapshot being filled by the running simulation graph
+
+	bool headless_{};
+	bool headless_finished_{}; // ofExit only quits after the current frame
+	int headless_frames_{};
+	int headless_frame_{};
+	uint64_t headless_start_{};
+	RenderSnapshot headless_snapshot_;
+	vector<float> headless_audio_buffer_;
+
+	struct BenchmarkScene {
+		string name;
+		string path;
+		int stress_count;	// > 0 generates that many entities into a blank scene instead of loading one
+	};
+
+	bool benchmarking_{};
+	int benchmark_seed_{};
+	string benchmark_output_;
+	vector<BenchmarkScene> benchmark_scenes_;
+	int benchmark_scene_{};
+	Benchmark benchmark_;
+
+	bool microbenchmarking_{};
+
+	int batch_eval_count_{};
+	string batch_eval_output_;
+	int batch_eval_seed_{};
+	int batch_eval_threads_{};
+
+	int trace_first_frame_{ -1 };
+	int trace_frame_count_{};
+	string trace_output_;
+
+	float update_time_{};	// ms, last frame's
+	float draw_time_{};
+
+	int update_allocation_tag_{};
+	int draw_allocation_tag_{};
+	int audio_allocation_tag_{};
 	
 };
@@ -0,0 +1,176 @@
+#include "JobSystem.h"
+
+thread_local int JobSystem::queue_index_ = 0;
+
+JobSystem::JobSystem()
+	:	pending_(0)
+	,	running_(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+	stop();
+}
+
+void JobSystem::start(int worker_count)
+{
+	if (running_) return;
+
+	if (worker_count < 0) worker_count = max(1, static_cast<int>(thread::hardware_concurrency()) - 2);
+
+	queues_.clear();
+	for (int i = 0; i < worker_count + 1; i++)
+	{
+		queues_.push_back(make_unique<WorkerQueue>());
+	}
+
+	running_ = true;
+	for (int i = 0; i < worker_count; i++)
+	{
+		workers_.emplace_back(&JobSystem::worker_loop, this, i + 1);
+	}
+
+	cout << "------------JobSystem.cpp------------" << endl;
+	cout << " - Workers: " << worker_count << endl;
+	cout << "-------------------------------------" << endl;
+}
+
+void JobSystem::stop()
+{
+	if (!running_) return;
+
+	{
+		lock_guard<mutex> lock(sleep_mutex_);
+		running_ = false;
+	}
+	wake_.notify_all();
+
+	for (auto& worker : workers_)
+	{
+		worker.join();
+	}
+	workers_.clear();
+	queues_.clear();
+}
+
+void JobSystem::submit(Job job)
+{
+	// no pool (or stopped) - just run it here
+	if (!running_)
+	{
+		job();
+		return;
+	}
+
+	WorkerQueue& queue = *queues_[queue_index_];
+	{
+		lock_guard<mutex> lock(queue.jobs_mutex);
+		queue.jobs.push_back(move(job));
+	}
+
+	{
+		lock_guard<mutex> lock(sleep_mutex_);
+		pending_++;
+	}
+	wake_.notify_one();
+}
+
+bool JobSystem::run_one()
+{
+	if (!running_) return false;
+
+	Job job;
+	if (!pop(queue_index_, job) && !steal(queue_index_, job)) return false;
+
+	pending_--;
+	job();
+	return true;
+}
+
+void JobSystem::parallel_for(const int count, const int grain, const RangeJob& job)
+{
+	if (count <= 0) return;
+
+	// not worth the hand-off for small ranges
+	const int chunk_count = min(count / max(grain, 1), get_worker_count() + 1);
+	if (!running_ || chunk_count <= 1)
+	{
+		job(0, count);
+		return;
+	}
+
+	atomic<int> remaining(chunk_count);
+	const int chunk_size = (count + chunk_count - 1) / chunk_count;
+	const int allocation_tag = AllocationTracker::get_tag();
+	WorldContext* world = WorldContext::get_current();
+	for (int i = 1; i < chunk_count; i++)
+	{
+		const int begin = i * chunk_size;
+		const int end = min(begin + chunk_size, count);
+		submit([&job, &remaining, begin, end, allocation_tag, world] {
+			AllocationScope allocation_scope(allocation_tag);
+			WorldScope world_scope(world);
+			if (begin < end) job(begin, end);
+			remaining--;
+		});
+	}
+
+	// the first chunk runs here, then help with whatever is left
+	job(0, min(chunk_size, count));
+	remaining--;
+
+	while (remaining > 0)
+	{
+		if (!run_one()) this_thread::yield();
+	}
+}
+
+void JobSystem::worker_loop(const int index)
+{
+	queue_index_ = index;
+	Profiler::set_thread_name("worker " + ofToString(index));
+
+	while (running_)
+	{
+		Job job;
+		if (pop(index, job) || steal(index, job))
+		{
+			pending_--;
+			job();
+			continue;
+		}
+
+		unique_lock<mutex> lock(sleep_mutex_);
+		wake_.wait(lock, [this] { return pending_ > 0 || !running_; });
+	}
+}
+
+bool JobSystem::pop(const int index, Job& job)
+{
+	WorkerQueue& queue = *queues_[index];
+	lock_guard<mutex> lock(queue.jobs_mutex);
+	if (queue.jobs.empty()) return false;
+
+	// newest first - it's the most likely to still be in cache
+	job = move(queue.jobs.back());
+	queue.jobs.pop_back();
+	return true;
+}
+
+bool JobSystem::steal(const int thief, Job& job)
+{
+	const int count = static_cast<int>(queues_.size());
+	for (int i = 1; i < count; i++)
+	{
+		WorkerQueue& queue = *queues_[(thief + i) % count];
+		lock_guard<mutex> lock(queue.jobs_mutex);
+		if (queue.jobs.empty()) continue;
+
+		// oldest first, away from the end the owner works on
+		job = move(queue.jobs.front());
+		queue.jobs.pop_front();
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "ofMain.h"
+#include "AllocationTracker.h"
+#include "core/WorldContext.h"
+#include "Profiler.h"
+
+// small work-stealing thread pool
+// every worker owns a queue - it takes its own newest job first and, once that's empty, steals the oldest job from someone else
+// threads outside the pool (the render and simulation threads) submit into a shared queue and help out while they wait
+class JobSystem {
+
+public:
+
+	typedef function<void()> Job;
+	typedef function<void(int begin, int end)> RangeJob;
+
+	JobSystem();
+	~JobSystem();
+
+	// worker_count < 0 uses one worker per hardware thread, minus the two the app already keeps busy
+	void start(int worker_count = -1);
+	void stop();
+
+	void submit(Job job);
+
+	// runs one pending job on the calling thread, returns false if there was nothing to run
+	bool run_one();
+
+	// splits [0, count) into chunks of at least grain items and runs them across the pool, returns once every chunk is done
+	// chunks count their allocations against the caller's allocation tag, and work on the caller's world
+	void parallel_for(int count, int grain, const RangeJob& job);
+
+	int get_worker_count() const { return static_cast<int>(workers_.size()); }
+
+private:
+
+	struct WorkerQueue {
+		mutex jobs_mutex;
+		deque<Job> jobs;
+	};
+
+	void worker_loop(int index);
+
+	bool pop(int index, Job& job);
+	bool steal(int thief, Job& job);
+
+	// queue 0 is shared by outside threads, worker n owns queue n + 1
+	vector<unique_ptr<WorkerQueue>> queues_;
+	vector<thread> workers_;
+
+	mutex sleep_mutex_;
+	condition_variable wake_;
+	atomic<int> pending_;
+	atomic<bool> running_;
+
+	static thread_local int queue_index_;
+
+};
@@ -1,10 +1,12 @@
 #include "Mass.h"
 
+#include "core/MathUtils.h"
+
 Mass::Mass(const ofVec2f pos, const float mass, const float radius)
 {
 	set_type("Mass");
 
-	set_position(pos);
+	set_position(Vec2(pos));
 	set_mass(mass);
 	set_radius(radius);
 	set_color(ofColor(passive_color_));
@@ -28,22 +30,20 @@ void Mass::update()
 
 void Mass::update_forces()
 {
-	apply_force(accel_, get_fluid_force(), false);
-	add_forces(false);
+	body_.apply_force(body_.accel, get_fluid_force(), false);
+	body_.add_forces();
 }
 
-ofVec2f Mass::get_fluid_force()
+Vec2 Mass::get_fluid_force()
 {
-	const ofVec2f inv_window_size(1.0f / WORLD_WIDTH, 1.0f / WORLD_HEIGHT);
-	const ofVec2f window_size(WORLD_WIDTH, WORLD_HEIGHT);	
-	force_ = fluid_manager_->get_solver()->getVelocityAtPos(ofVec2f(pos_.x + HALF_WORLD_WIDTH, pos_.y + HALF_WORLD_HEIGHT) * inv_window_size) * ofMap(get_mass(), 0, 5000, 0.003f, 0.00006f) * window_size + force_ * 0.5f;
+	const Vec2 window_size(world::WORLD_WIDTH, world::WORLD_HEIGHT);	
+	force_ = fluid_manager_->get_field().velocity_at_world(body_.pos) * remap(get_mass(), 0, 5000, 0.003f, 0.00006f) * window_size + force_ * 0.5f;
 	return force_;
 }
 
 void Mass::drag_nodes()
 {
 	local_mouse_pos_before_drag_.set(cam_->get_local_mouse_pos());
-	static ofVec2f mouse_pos_before_drag;
 	
 	if (mouse_drag_)
 	{
@@ -54,22 +54,22 @@ void Mass::drag_nodes()
 		
 		const ofVec2f prev_pos2 = ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y);
 
-		ofVec2f new_pos;
-		new_pos.x = ofLerp(pos_.x, prev_pos2.x, 0.1f);
-		new_pos.y = ofLerp(pos_.y, prev_pos2.y, 0.1f);
+		Vec2 new_pos;
+		new_pos.x = ofLerp(body_.pos.x, prev_pos2.x, 0.1f);
+		new_pos.y = ofLerp(body_.pos.y, prev_pos2.y, 0.1f);
 		
 		set_position(new_pos);
-		set_velocity(ofVec2f(0));
+		set_velocity(Vec2());
 
-		mouse_pos_before_drag = ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y);
+		world_mouse_pos_before_drag_ = ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y);
 	}
 	else
 	{
 		if (started_dragging_ == true)
 		{
 			started_dragging_ = false;
-			const ofVec2f mouse_speed = (ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y) - mouse_pos_before_drag) / 3;
-			apply_force(accel_, mouse_speed, false);
+			const ofVec2f mouse_speed = (ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y) - world_mouse_pos_before_drag_) / 3;
+			body_.apply_force(body_.accel, Vec2(mouse_speed), false);
 		}
 	}
 }
@@ -80,20 +80,20 @@ void Mass::update_gui()
 	{
 		if (gui_values_need_to_be_set_)
 		{
-			gui_manager_->update_mass_values(pos_, vel_, accel_, mass_, radius_);
+			gui_manager_->update_mass_values(body_.pos, body_.vel, body_.accel, body_.mass, body_.radius);
 			gui_values_need_to_be_set_ = false;
 		}
 		else {
-			gui_manager_->update_mass_values(pos_, vel_, accel_, gui_manager_->gui_node_mass, gui_manager_->gui_node_radius);
-			radius_ = gui_manager_->gui_node_radius;
-			mass_ = gui_manager_->gui_node_mass;
+			gui_manager_->update_mass_values(body_.pos, body_.vel, body_.accel, gui_manager_->gui_node_mass, gui_manager_->gui_node_radius);
+			body_.radius = gui_manager_->gui_node_radius;
+			body_.mass = gui_manager_->gui_node_mass;
 		}
 	}
 }
 
 void Mass::reset_forces()
 {
-	accel_.set(0);
+	body_.accel = Vec2();
 }
 
 
@@ -120,7 +120,7 @@ void Mass::mouse_dragged(const float x, const float y, const int button)
 	{
 		if (mouse_over_ && game_controller_->get_mouse_dragged() == false)
 		{
-			if (local_mouse_pos_before_drag_.distance(ofVec2f(ofGetMouseX() / 2 - ofGetWidth() / 2, ofGetMouseY() - ofGetHeight() / 2)) > pixel_buffer_before_drag_)
+			if (local_mouse_pos_before_drag_.distance(ofVec2f(step_input_->mouse_x / 2 - step_input_->window_width / 2, step_input_->mouse_y - step_input_->window_height / 2)) > pixel_buffer_before_drag_)
 			{
 				// the node will only be moved by the mouse if it has been moved by more than 1 pixel - this prevents accidentally stopping something by selecting it
 				mouse_drag_ = true;
@@ -147,29 +147,18 @@ void Mass::mouse_released(const float x, const float y, const int button)
 
 void Mass::draw()
 {
-	ofPushStyle();
-
-	ofSetColor(ofColor(0, 0, 0, 50));
-	ofFill();
-	ofDrawEllipse(pos_.x, pos_.y, radius_, radius_);
-
-	get_color();
-	ofNoFill();
-	ofSetLineWidth(ofMap(mass_, MINIMUM_MASS, MAXIMUM_MASS, 0.1f, 10.0f));
-
-	ofDrawEllipse(pos_.x, pos_.y, radius_, radius_);
-
-	ofPopStyle();
+	batch_renderer_->add_fill(body_.pos, body_.radius, ofColor(0, 0, 0, 50));
+	batch_renderer_->add_outline(body_.pos, body_.radius, ofMap(body_.mass, world::MINIMUM_MASS, world::MAXIMUM_MASS, 0.1f, 10.0f), get_color());
 }
 
-void Mass::get_color() const
+ofColor Mass::get_color() const
 {
 	if ((gamemode_manager_->get_current_mode_string() == "Sandbox") && ((get_is_selected() == true) || (mouse_over_ || mouse_drag_)))
 	{
-		ofSetColor(selected_color_);
+		return selected_color_;
 	}
 	else
 	{
-		ofSetColor(ofColor(color_.r, color_.g, color_.b));
+		return ofColor(color_.r, color_.g, color_.b);
 	}
 }
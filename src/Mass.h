@@ -15,7 +15,7 @@ private:
 
 	// Physics/movement
 	void update_forces();
-	ofVec2f get_fluid_force();
+	Vec2 get_fluid_force();
 	void reset_forces();
 	
 	void drag_nodes();
@@ -26,13 +26,13 @@ private:
 	// Draw
 	void draw() override;
 	
-	void get_color() const;
+	ofColor get_color() const;
 	
 	// Events
 	void mouse_pressed(float x, float y, int button) override;
 	void mouse_dragged(float x, float y, int button) override;
 	void mouse_released(float x, float y, int button) override;
 
-	ofVec2f force_;
+	Vec2 force_;
 	
 };
@@ -0,0 +1,195 @@
+#include "Microbench.h"
+
+#include "Iota.h"
+#include "core/SpringChain.h"
+
+Microbench::Microbench(Iota& app)
+	:	app_(app)
+	,	sink_(0)
+{
+}
+
+void Microbench::run()
+{
+	cout << "------------Microbench.cpp------------" << endl;
+
+	for (const int count : { 1000, 10000, 100000 }) bench_ellipse_compare(count);
+	for (const int count : { 2, 8, 32, 128 }) bench_spring_force(count);
+	for (const int count : { 1000, 10000, MAX_PARTICLES }) bench_particle_update(count);
+	for (const int count : { 1000, 10000, 100000 }) bench_velocity_at_pos(count);
+	for (const int count : { 100, 1000, 10000 }) bench_add_to_fluid(count);
+	for (const int count : { 64, 256, 1024, 4096 }) bench_ellipse_collider(count);
+	for (const int count : { 1000, 100000 }) bench_random(count);
+	bench_audio_out();
+
+	cout << "--------------------------------------" << endl;
+}
+
+void Microbench::bench_ellipse_compare(const int count)
+{
+	vector<Vec2> positions(count + 1);
+	vector<float> radiuses(count + 1);
+	for (int i = 0; i <= count; i++)
+	{
+		positions[i] = Vec2(ofRandom(-world::HALF_WORLD_WIDTH, world::HALF_WORLD_WIDTH), ofRandom(-world::HALF_WORLD_HEIGHT, world::HALF_WORLD_HEIGHT));
+		radiuses[i] = ofRandom(world::RADIUS_LOWER_BOUND, world::RADIUS_UPPER_BOUND);
+	}
+
+	measure("Collisions::ellipse_compare", count, count, [&] {
+		int hits = 0;
+		for (int i = 0; i < count; i++)
+		{
+			hits += Collisions::ellipse_compare(positions[i], radiuses[i], positions[i + 1], radiuses[i + 1]);
+		}
+		sink_ = hits;
+	});
+}
+
+void Microbench::bench_random(const int count)
+{
+	vector<float> values(count);
+
+	measure("ofRandom", count, count, [&] {
+		for (int i = 0; i < count; i++) values[i] = ofRandom(0, 1);
+		sink_ = values[count - 1];
+	});
+
+	RandomStream random;
+	measure("RandomStream::range", count, count, [&] {
+		for (int i = 0; i < count; i++) values[i] = random.range(0, 1);
+		sink_ = values[count - 1];
+	});
+
+	measure("RandomStream::fill", count, count, [&] {
+		random.fill(values.data(), count, 0, 1);
+		sink_ = values[count - 1];
+	});
+}
+
+void Microbench::bench_spring_force(const int node_count)
+{
+	// elements are nodes, each node's force looks at its neighbour below
+	Body body;
+	SpringChain chain(2, 2, 22);
+	RandomStream random;
+	for (int i = 0; i < node_count; i++)
+	{
+		chain.add_node(body, Vec2(random.range(-50.0f, 50.0f), 0), 30, 50);
+	}
+
+	measure("SpringChain::spring_force", node_count, node_count, [&] {
+		float total = 0;
+		for (int i = 0; i < node_count; i++)
+		{
+			total += chain.spring_force(body, i).x;
+		}
+		sink_ = total;
+	});
+}
+
+void Microbench::bench_particle_update(const int count)
+{
+	const FluidField& fluid = app_.fluid_manager.get_field();
+	const Vec2 window_size(world::WORLD_WIDTH, world::WORLD_HEIGHT);
+	const Vec2 inv_window_size(1.0f / world::WORLD_WIDTH, 1.0f / world::WORLD_HEIGHT);
+
+	RandomStream random;
+	vector<Particle> particles(count);
+	for (auto& particle : particles)
+	{
+		const float x = random.range(0, world::WORLD_WIDTH);
+		const float y = random.range(0, world::WORLD_HEIGHT);
+		particle.init(x, y, random);
+	}
+	vector<float> positions(count * 2 * 2);
+	vector<float> colors(count * 3 * 2);
+
+	measure("Particle::update", count, count, [&] {
+		for (auto& particle : particles)
+		{
+			// keep them alive, update fades them out
+			particle.alpha = 1;
+			particle.update(fluid, window_size, inv_window_size, random);
+		}
+	});
+
+	measure("Particle::update_vertex_arrays", count, count, [&] {
+		for (int i = 0; i < count; i++)
+		{
+			particles[i].alpha = 1;
+			particles[i].update_vertex_arrays(true, inv_window_size, i, positions.data(), colors.data());
+		}
+		sink_ = positions[0];
+	});
+}
+
+void Microbench::bench_velocity_at_pos(const int count)
+{
+	const msa::fluid::Solver& solver = *app_.fluid_manager.get_solver();
+
+	vector<ofVec2f> positions(count);
+	for (auto& pos : positions)
+	{
+		pos.set(ofRandom(1), ofRandom(1));
+	}
+
+	measure("Solver::getVelocityAtPos", count, count, [&] {
+		float total = 0;
+		for (auto& pos : positions)
+		{
+			total += solver.getVelocityAtPos(pos).x;
+		}
+		sink_ = total;
+	});
+}
+
+void Microbench::bench_add_to_fluid(const int count)
+{
+	vector<ofVec2f> positions(count);
+	for (auto& pos : positions)
+	{
+		pos.set(ofRandom(1), ofRandom(1));
+	}
+
+	// elements are calls - each one adds to 10 cells by default
+	measure("FluidManager::add_to_fluid", count, count, [&] {
+		for (auto& pos : positions)
+		{
+			app_.fluid_manager.add_to_fluid(pos, ofVec2f(0.001f, 0.001f), true, true);
+		}
+	});
+
+	app_.fluid_manager.reset_fluid();
+}
+
+void Microbench::bench_ellipse_collider(const int object_count)
+{
+	// the contact search every collider runs in the compute phase of the entity step, elements are object pairs tested
+	vector<GameObject*> objects;
+	vector<unique_ptr<Mass>> masses;
+	for (int i = 0; i < object_count; i++)
+	{
+		masses.push_back(make_unique<Mass>(ofVec2f(ofRandom(-world::HALF_WORLD_WIDTH, world::HALF_WORLD_WIDTH), ofRandom(-world::HALF_WORLD_HEIGHT, world::HALF_WORLD_HEIGHT)), 500, ofRandom(world::RADIUS_LOWER_BOUND, world::RADIUS_UPPER_BOUND)));
+		masses.back()->init(&objects, &app_.game_controller, &app_.gui_manager, &app_.cam, &app_.fluid_manager, &app_.audio_manager, &app_.gamemode_manager, &app_.step_input, nullptr);
+		objects.push_back(masses.back().get());
+	}
+
+	measure("GameObject::ellipse_collider", object_count, static_cast<double>(object_count) * object_count, [&] {
+		for (auto& object : objects)
+		{
+			object->root_compute_interactions();
+		}
+	});
+}
+
+void Microbench::bench_audio_out()
+{
+	const int buffer_size = app_.audio_manager.bufferSize;
+	vector<float> buffer(buffer_size * 2);
+
+	// elements are stereo frames
+	measure("AudioManager::audioOut", buffer_size, buffer_size, [&] {
+		app_.audio_manager.audioOut(buffer.data(), buffer_size, 2);
+		sink_ = buffer[0];
+	});
+}
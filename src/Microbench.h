@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+
+#include "ofMain.h"
+
+class Iota;
+
+#define MICROBENCH_MIN_TIME_MS 200 // each kernel/size pair repeats until it has run at least this long
+
+// isolated timings of the hot kernels at increasing problem sizes (--microbench)
+// runs inside a headless app, so the kernels see real, initialised managers - reports ns per element and elements per second
+class Microbench {
+
+public:
+
+	explicit Microbench(Iota& app);
+
+	void run();
+
+private:
+
+	void bench_ellipse_compare(int count);
+	void bench_spring_force(int node_count);
+	void bench_particle_update(int count);
+	void bench_velocity_at_pos(int count);
+	void bench_add_to_fluid(int count);
+	void bench_ellipse_collider(int object_count);
+	void bench_random(int count);
+	void bench_audio_out();
+
+	// repeats work until MICROBENCH_MIN_TIME_MS has passed, elements is how many items one call of work handles
+	template <typename Work>
+	void measure(const string& kernel, int size, double elements, Work work);
+
+	Iota& app_;
+	volatile float sink_; // results are written here so the timed loops aren't optimised away
+
+};
+
+template <typename Work>
+void Microbench::measure(const string& kernel, const int size, const double elements, Work work)
+{
+	typedef chrono::steady_clock clock;
+
+	work(); // warm up caches and any lazy allocation
+
+	long long repetitions = 0;
+	const clock::time_point start = clock::now();
+	clock::time_point now = start;
+	do
+	{
+		work();
+		repetitions++;
+		now = clock::now();
+	} while (chrono::duration_cast<chrono::milliseconds>(now - start).count() < MICROBENCH_MIN_TIME_MS);
+
+	const double seconds = chrono::duration<double>(now - start).count();
+	const double ns_per_element = seconds * 1e9 / (repetitions * elements);
+	const double elements_per_second = repetitions * elements / seconds;
+
+	cout << " - " << kernel << " [" << size << "]: " << ofToString(ns_per_element, 2) << " ns/element, " << ofToString(elements_per_second / 1e6, 2) << " M elements/s" << endl;
+}
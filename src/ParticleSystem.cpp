@@ -13,37 +13,113 @@
 
 ParticleSystem::ParticleSystem() {
 	cur_index_ = 0;
+	live_count_ = 0;
 }
 
-void ParticleSystem::update_and_draw(const msa::fluid::Solver &a_solver, const ofVec2f window_size, const bool drawing_fluid, GameObject* player) {
-	const ofVec2f inv_window_size(1.0f / window_size.x, 1.0f / window_size.y);
+void ParticleSystem::update(const FluidField& fluid, const ofVec2f window_size, const bool drawing_fluid, GameObject* player, const ofRectangle& visible_rect, const float world_units_per_pixel, ParticleSnapshot& snapshot) {
+	const Vec2 core_window_size(window_size);
+	const Vec2 inv_window_size(1.0f / window_size.x, 1.0f / window_size.y);
+
+	snapshot.visible = true;
+	snapshot.splat = world_units_per_pixel >= PARTICLE_SPLAT_UNITS_PER_PIXEL;
+	if (snapshot.splat) {
+		update_splats(fluid, core_window_size, inv_window_size, drawing_fluid, world_units_per_pixel, snapshot);
+	}
+	else {
+		update_lines(fluid, core_window_size, inv_window_size, drawing_fluid, visible_rect, snapshot);
+	}
+
+	vel = fluid.velocity_at(pos * inv_window_size) * (1 * 0.6f) * core_window_size + Vec2(player->get_velocity()) * 0.5f;
+	pos += vel;
+}
+
+void ParticleSystem::update_lines(const FluidField& fluid, const Vec2 window_size, const Vec2 inv_window_size, const bool drawing_fluid, const ofRectangle& visible_rect, ParticleSnapshot& snapshot) {
+	snapshot.positions.resize(MAX_PARTICLES * 2 * 2);
+	snapshot.colors.resize(MAX_PARTICLES * 3 * 2);
+
+	// every live particle is simulated, but only the ones on screen are written (packed) into the vertex arrays
+	const float left = visible_rect.getLeft();
+	const float top = visible_rect.getTop();
+	const float right = visible_rect.getRight();
+	const float bottom = visible_rect.getBottom();
+	RandomStream& random = Random::get(RANDOM_PARTICLES);
+	int visible_count = 0;
+	live_count_ = 0;
+	for(int i=0; i<MAX_PARTICLES; i++) {
+		if(particles_[i].alpha > 0) {
+			live_count_++;
+			particles_[i].update(fluid, window_size, inv_window_size, random);
+			if(particles_[i].is_within(left, top, right, bottom)) {
+				particles_[i].update_vertex_arrays(drawing_fluid, inv_window_size, visible_count, snapshot.positions.data(), snapshot.colors.data());
+				visible_count++;
+			}
+		}
+	}
+	snapshot.line_count = visible_count;
+}
+
+void ParticleSystem::update_splats(const FluidField& fluid, const Vec2 window_size, const Vec2 inv_window_size, const bool drawing_fluid, const float world_units_per_pixel, ParticleSnapshot& snapshot) {
+	// zoomed out the lines are sub-pixel anyway - scatter them into a low resolution image that's drawn once, so the gpu cost no longer depends on the particle count
+	const int grid_width = static_cast<int>(window_size.x) / PARTICLE_SPLAT_TEXEL_SIZE;
+	const int grid_height = static_cast<int>(window_size.y) / PARTICLE_SPLAT_TEXEL_SIZE;
+	const int count = grid_width * grid_height * 3;
+
+	splat_density_.resize(count);
+	fill(splat_density_.begin(), splat_density_.end(), 0.0f);
+
+	// a one pixel wide line of length l lights l / upp screen pixels, spread over the (texel / upp)^2 pixels of its texel
+	const float weight = world_units_per_pixel / (PARTICLE_SPLAT_TEXEL_SIZE * PARTICLE_SPLAT_TEXEL_SIZE);
+	RandomStream& random = Random::get(RANDOM_PARTICLES);
+	live_count_ = 0;
+	for(int i=0; i<MAX_PARTICLES; i++) {
+		if(particles_[i].alpha > 0) {
+			live_count_++;
+			particles_[i].update(fluid, window_size, inv_window_size, random);
+			particles_[i].splat(drawing_fluid, inv_window_size, splat_density_.data(), grid_width, grid_height, PARTICLE_SPLAT_TEXEL_SIZE, weight);
+		}
+	}
+
+	snapshot.splat_width = grid_width;
+	snapshot.splat_height = grid_height;
+	snapshot.splat_pixels.resize(count);
+	for(int i=0; i<count; i++) {
+		snapshot.splat_pixels[i] = static_cast<unsigned char>(min(splat_density_[i] * 255.0f, 255.0f));
+	}
+}
+
+void ParticleSystem::draw(const ParticleSnapshot& snapshot, const ofVec2f window_size) {
+	if (!snapshot.visible) return;
 
 	glEnable(GL_BLEND);
 	glDisable(GL_TEXTURE_2D);
     glBlendFunc(GL_ONE,GL_ONE);
     ofSetLineWidth(1);
-	
-	for(int i=0; i<MAX_PARTICLES; i++) {
-		if(particles_[i].alpha > 0) {
-			particles_[i].update(a_solver, window_size, inv_window_size, player);
-			particles_[i].update_vertex_arrays(drawing_fluid, inv_window_size, i, pos_array_, col_array_, player);			
+
+	if (snapshot.splat) {
+		if (!splat_texture_.isAllocated() || splat_texture_.getWidth() != snapshot.splat_width || splat_texture_.getHeight() != snapshot.splat_height) {
+			splat_texture_.allocate(snapshot.splat_width, snapshot.splat_height, GL_RGB);
 		}
+		splat_texture_.loadData(snapshot.splat_pixels.data(), snapshot.splat_width, snapshot.splat_height, GL_RGB);
+
+		ofPushStyle();
+		ofSetColor(255);
+		splat_texture_.draw(0, 0, window_size.x, window_size.y);
+		ofPopStyle();
+		glBlendFunc(GL_ONE, GL_ONE);
+	}
+	else if (snapshot.line_count > 0) {
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, snapshot.positions.data());
+		
+		glEnableClientState(GL_COLOR_ARRAY);
+		glColorPointer(3, GL_FLOAT, 0, snapshot.colors.data());
+		
+		glDrawArrays(GL_LINES, 0, snapshot.line_count * 2);
+		
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glDisableClientState(GL_COLOR_ARRAY);
 	}
 
-	vel = a_solver.getVelocityAtPos(pos * inv_window_size) * (1 * 0.6f) * window_size + player->get_velocity() * 0.5f;
-	pos += vel;
-	
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glVertexPointer(2, GL_FLOAT, 0, pos_array_);
-	
-	glEnableClientState(GL_COLOR_ARRAY);
-	glColorPointer(3, GL_FLOAT, 0, col_array_);
-	
-	glDrawArrays(GL_LINES, 0, MAX_PARTICLES * 2);
-	
-	glDisableClientState(GL_VERTEX_ARRAY);
-	glDisableClientState(GL_COLOR_ARRAY);
-	
 	glDisable(GL_BLEND);
 }
 
@@ -55,7 +131,7 @@ void ParticleSystem::add_particles(const ofVec2f &pos, const int count){
 
 
 void ParticleSystem::add_particle(const ofVec2f &pos) {
-	particles_[cur_index_].init(pos.x, pos.y);
+	particles_[cur_index_].init(pos.x, pos.y, Random::get(RANDOM_PARTICLES));
 	cur_index_++;
 	if(cur_index_ >= MAX_PARTICLES) cur_index_ = 0;
 }
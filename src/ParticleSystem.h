@@ -1,27 +1,46 @@
 #pragma once
 
-#include "Particle.h"
+#include "core/Particle.h"
+#include "RenderSnapshot.h"
+
+class GameObject;
 
 #define MAX_PARTICLES		48000
 
+// zoomed out past this many world units per screen pixel, particles are splatted into a density texture instead of drawn as lines
+#define PARTICLE_SPLAT_UNITS_PER_PIXEL	2.0f
+#define PARTICLE_SPLAT_TEXEL_SIZE		5	// world units per texel
+
 class ParticleSystem
 {
 public:
 
 	ParticleSystem();
 
-	void update_and_draw(const msa::fluid::Solver& a_solver, const ofVec2f window_size, const bool drawing_fluid, GameObject* player);
+	// simulation thread - moves every live particle and writes what should be drawn into the snapshot
+	void update(const FluidField& fluid, const ofVec2f window_size, const bool drawing_fluid, GameObject* player, const ofRectangle& visible_rect, float world_units_per_pixel, ParticleSnapshot& snapshot);
+	// render thread
+	void draw(const ParticleSnapshot& snapshot, const ofVec2f window_size);
 	void add_particles(const ofVec2f& pos, int count);
 	void add_particle(const ofVec2f& pos);
 
+	// live particles as of the last update
+	int get_live_count() const { return live_count_; }
+
 private:
 
-	float pos_array_[MAX_PARTICLES * 2 * 2];
-	float col_array_[MAX_PARTICLES * 3 * 2];
+	void update_lines(const FluidField& fluid, Vec2 window_size, Vec2 inv_window_size, bool drawing_fluid, const ofRectangle& visible_rect, ParticleSnapshot& snapshot);
+	void update_splats(const FluidField& fluid, Vec2 window_size, Vec2 inv_window_size, bool drawing_fluid, float world_units_per_pixel, ParticleSnapshot& snapshot);
+
 	int cur_index_;
+	int live_count_;
 
 	Particle particles_[MAX_PARTICLES];
 
-	ofVec2f pos{ ofRandom(0, 4000), ofRandom(0, 3000) };
-	ofVec2f vel{};
+	// low resolution lod, only allocated once it's first needed
+	vector<float> splat_density_;	// simulation thread scratch
+	ofTexture splat_texture_;		// render thread
+
+	Vec2 pos{ Random::get(RANDOM_PARTICLES).range(0, 4000), Random::get(RANDOM_PARTICLES).range(0, 3000) };
+	Vec2 vel{};
 };
@@ -4,14 +4,16 @@ Player::Player(const ofVec2f pos, const ofColor color, const float radius)
 	:	movement_speed(0.20f)
 	,	mouse_down_(false)
 	,	mouse_button_(-1)
-	,	mouse_pos_(0)
+	,	mouse_pos_(0, 0)
 	,	aiming_boost_(false)
 	,	player_following_mouse_(false)
+	,	gui_values_sent_(false)
 {
 	set_type("Player");
-	set_position(pos);
+	pull_range_.set_type("PullRange");
+	set_position(Vec2(pos));
 	set_color(color);
-	set_velocity(ofVec2f(0));
+	set_velocity(Vec2());
 	set_radius(radius);
 	set_mass(500);
 	
@@ -22,6 +24,28 @@ Player::Player(const ofVec2f pos, const ofColor color, const float radius)
 	add_module("mouseHover");
 }
 
+// finds the collectables in pull range - they are pulled in the commit phase, once it's this object's turn
+void Player::compute_interactions()
+{
+	pull_targets_.clear();
+	for (auto& game_object : *game_objects_)
+	{
+		if (game_object->can_collide())
+		{
+			if (game_object != this)
+			{
+				if (game_object->get_type() == "Collectable")
+				{
+					if (Collisions::ellipse_compare(body_.pos, 600, game_object->get_body().pos, game_object->get_radius()))
+					{
+						pull_targets_.push_back(game_object);
+					}
+				}
+			}
+		}
+	}
+}
+
 void Player::update()
 {
 	follow_mouse();
@@ -42,15 +66,15 @@ void Player::player_particles()
 void Player::update_forces()
 {
 	apply_all_forces();
-	add_forces(true);
+	body_.add_forces_interpolated(step_input_->frame);
 }
 
 void Player::apply_all_forces()
 {
 	if (player_can_move())
 	{
-		mouse_pos_ = ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y);
-		apply_force(accel_, get_movement_vector(), true, movement_speed);
+		mouse_pos_ = Vec2(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y);
+		body_.apply_force(body_.accel, get_movement_vector(), true, movement_speed);
 		audio_manager_->event_player_started_moving();
 	}
 	else
@@ -69,18 +93,16 @@ bool Player::player_can_move() const
 	}
 }
 
-ofVec2f Player::get_movement_vector() const
+Vec2 Player::get_movement_vector() const
 {
-	ofVec2f movement_vec = pos_ - mouse_pos_;
-	movement_vec.scale(5);
-	return movement_vec;	
+	return (body_.pos - mouse_pos_).normalized() * 5;
 }
 
 void Player::follow_mouse()
 {
 	if (player_following_mouse_)
 	{
-		set_position(ofVec2f(cam_->get_world_mouse_pos().x, cam_->get_world_mouse_pos().y));
+		set_position(Vec2(cam_->get_world_mouse_pos()));
 	}
 	// to avoid the player moving after the menu is open
 	else if (gamemode_manager_->get_current_mode_string() == "Menu" && mouse_down_)
@@ -91,25 +113,11 @@ void Player::follow_mouse()
 
 void Player::pull_points()
 {
-	for (auto& game_object : *game_objects_)
+	for (auto& game_object : pull_targets_)
 	{
-		if (game_object->can_collide())
-		{
-			if (game_object != this)
-			{
-				if (game_object->get_type() == "Collectable")
-				{
-					if (Collisions::ellipse_compare(pos_, 600, game_object->get_position(), game_object->get_radius()))
-					{											
-						// move points towards player
-						GameObject pull_range;
-						pull_range.set_position(pos_);
-						pull_range.set_type("PullRange");
-						game_object->is_colliding(&pull_range);
-					}
-				}
-			}
-		}
+		// move points towards player
+		pull_range_.set_position(body_.pos);
+		game_object->is_colliding(&pull_range_, body_.pos);
 	}
 }
 
@@ -117,23 +125,22 @@ void Player::update_gui()
 {
 	if (get_is_selected())
 	{
-		static bool initiai_values_triggered = false; // initial values are sent to the gui_manager initially, after which it will update the results internally, and the object can receive the values back
-		if (!initiai_values_triggered) {
-			initiai_values_triggered = true;
-			gui_manager_->update_player_values(pos_, vel_, accel_, mass_, infinite_mass_, radius_);
+		if (!gui_values_sent_) {
+			gui_values_sent_ = true;
+			gui_manager_->update_player_values(body_.pos, body_.vel, body_.accel, body_.mass, body_.infinite_mass, body_.radius);
 		}
 		else {
-			gui_manager_->update_player_values(pos_, vel_, accel_, gui_manager_->gui_player_mass, gui_manager_->gui_player_infinite_mass, gui_manager_->gui_player_radius); // receiving and updating the results from the GUI_Manager
-			if (infinite_mass_) mass_ = 9999999999999999999.0f; else mass_ = gui_manager_->gui_player_mass;
-			radius_ = gui_manager_->gui_player_radius;
-			infinite_mass_ = gui_manager_->gui_player_infinite_mass;
+			gui_manager_->update_player_values(body_.pos, body_.vel, body_.accel, gui_manager_->gui_player_mass, gui_manager_->gui_player_infinite_mass, gui_manager_->gui_player_radius); // receiving and updating the results from the GUI_Manager
+			if (body_.infinite_mass) body_.mass = 9999999999999999999.0f; else body_.mass = gui_manager_->gui_player_mass;
+			body_.radius = gui_manager_->gui_player_radius;
+			body_.infinite_mass = gui_manager_->gui_player_infinite_mass;
 		}
 	}
 }
 
 void Player::reset_forces()
 {
-	accel_.set(0);
+	body_.accel = Vec2();
 }
 
 
@@ -192,8 +199,8 @@ void Player::key_released(const int key)
 void Player::boost_player()
 {
 	aiming_boost_ = false;
-	if (vel_.length() < 5) {
-		apply_force(accel_, (pos_ - ofVec2f(ofGetMouseX() - ofGetWidth() / 2, ofGetMouseY() - ofGetHeight() / 2)), true, 10);
+	if (body_.vel.length() < 5) {
+		body_.apply_force(body_.accel, body_.pos - step_input_->get_centered_mouse(), true, 10);
 	}
 }
 
@@ -203,8 +210,6 @@ void Player::boost_player()
 
 void Player::draw()
 {
-	ofPushStyle();
-	
 	draw_local_particle_effects();
 
 	if (gamemode_manager_->get_current_mode_string() != "Menu")
@@ -220,37 +225,21 @@ void Player::draw()
 
 		if (aiming_boost_) draw_boost_direction();
 
-		ofSetColor(color_);
-		ofFill();
-		ofDrawEllipse(pos_.x, pos_.y, radius_, radius_);
-
-		ofNoFill();
+		batch_renderer_->add_fill(body_.pos, body_.radius, color_);
 	}
-
-	ofPopStyle();
 }
 
 void Player::draw_boost_direction() const
 // draws dotted line in the direction the player is aiming
 {
-	ofPushMatrix();
-
-	glEnable(GL_LINE_STIPPLE);
-	glLineStipple(8, 0xAAAA);
-	glBegin(GL_LINES);
-	glVertex3f(pos_.x, pos_.y, 0);
-	glVertex3f(draw_vel_path().x, draw_vel_path().y, draw_vel_path().z);
-	glEnd();
-	glDisable(GL_LINE_STIPPLE);
-	glFlush();
-
-	ofPopMatrix();
+	const ofVec3f path = draw_vel_path();
+	batch_renderer_->add_dotted_line(body_.pos, Vec2(path.x, path.y));
 }
 
 ofVec3f Player::draw_vel_path() const
 {
-	const ofVec2f vec = pos_ - ofVec2f(ofGetMouseX() - ofGetWidth() / 2, ofGetMouseY() - ofGetHeight() / 2);
-	return ofVec3f(vec.x * ofGetWidth(), vec.y * ofGetHeight(), 0);
+	const Vec2 vec = body_.pos - step_input_->get_centered_mouse();
+	return ofVec3f(vec.x * step_input_->window_width, vec.y * step_input_->window_height, 0);
 }
 
 void Player::draw_fluid_trail() const
@@ -258,17 +247,18 @@ void Player::draw_fluid_trail() const
 {
 	if (mouse_down_ && mouse_button_ == 0)
 	{		
+		RandomStream& random = Random::get(RANDOM_PLAYER);
 		ofVec2f new_pos;
 		//new_pos.x = ofMap(pos_.x + ofRandom(-get_radius() / 4, get_radius() / 4), -HALF_WORLD_WIDTH, HALF_WORLD_WIDTH, 0, 1);
 		//new_pos.y = ofMap(pos_.y + ofRandom(-get_radius() / 4, get_radius() / 4), -HALF_WORLD_HEIGHT, HALF_WORLD_HEIGHT, 0, 1);
-		new_pos.x = ofMap(pos_.x + ofRandom(-get_radius() / 2, get_radius() / 2), -HALF_WORLD_WIDTH, HALF_WORLD_WIDTH, 0, 1);
-		new_pos.y = ofMap(pos_.y + ofRandom(-get_radius() / 2, get_radius() / 2), -HALF_WORLD_HEIGHT, HALF_WORLD_HEIGHT, 0, 1);
+		new_pos.x = ofMap(body_.pos.x + random.range(-get_radius() / 2, get_radius() / 2), -world::HALF_WORLD_WIDTH, world::HALF_WORLD_WIDTH, 0, 1);
+		new_pos.y = ofMap(body_.pos.y + random.range(-get_radius() / 2, get_radius() / 2), -world::HALF_WORLD_HEIGHT, world::HALF_WORLD_HEIGHT, 0, 1);
 
 		ofVec2f new_vel;
 		//new_vel.x = ((get_movement_vector().x + ofRandom(-1, 1)) / 6400) * -1;
 		//new_vel.y = ((get_movement_vector().y + ofRandom(-1, 1)) / 6400) * -1;
-		new_vel.x = ((get_movement_vector().x + ofRandom(-1, 1)) / 6400) * -1;
-		new_vel.y = ((get_movement_vector().y + ofRandom(-1, 1)) / 6400) * -1;
+		new_vel.x = ((get_movement_vector().x + random.range(-1, 1)) / 6400) * -1;
+		new_vel.y = ((get_movement_vector().y + random.range(-1, 1)) / 6400) * -1;
 
 		fluid_manager_->add_to_fluid(new_pos, new_vel, true, true);
 	}
@@ -278,28 +268,24 @@ void Player::create_particle_effects()
 {
 	if (mouse_down_ && mouse_button_ == 0)
 	{
-		ofVec2f movement_vec = pos_ - mouse_pos_;
-		movement_vec.scale(10);
+		const ofVec2f movement_vec = ((body_.pos - mouse_pos_).normalized() * 10).to<ofVec2f>();
 		float spawn_area = get_radius() / 4;
-		PlayerParticle particle(get_position() + ofVec2f(ofRandom(-spawn_area, spawn_area), ofRandom(-spawn_area, spawn_area)), movement_vec * -1 * 0.5, get_radius() * ofRandom(0.6, 0.8), ofColor(255, 255), ofRandom(25, 100));
-		player_particles_.push_back(particle);
+		RandomStream& random = Random::get(RANDOM_PLAYER);
+		const float offset_x = random.range(-spawn_area, spawn_area);
+		const float offset_y = random.range(-spawn_area, spawn_area);
+		const ofVec2f offset(offset_x, offset_y);
+		const float radius = get_radius() * random.range(0.6f, 0.8f);
+		const int lifetime = static_cast<int>(random.range(25, 100));
+		player_particles_.spawn(get_position() + offset, movement_vec * -1 * 0.5, radius, ofColor(255, 255), lifetime);
 	}
 }
 
 void Player::update_particle_effects()
 {
-	for (int i = 0; i < player_particles_.size(); i++)
-	{
-		if (player_particles_[i].needs_to_be_deleted)
-			player_particles_.erase(player_particles_.begin() + i);
-		player_particles_[i].update();
-	}
+	player_particles_.update();
 }
 
 void Player::draw_local_particle_effects()
 {
-	for (auto& i : player_particles_)
-	{
-		i.draw();
-	}
+	player_particles_.draw(*batch_renderer_);
 }
\ No newline at end of file
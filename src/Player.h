@@ -13,6 +13,7 @@ public:
 
 private:
 	
+	void compute_interactions() override;
 	void update() override;
 
 	// Physics/movement
@@ -21,7 +22,7 @@ private:
 	void reset_forces();
 	
 	bool player_can_move() const;
-	ofVec2f get_movement_vector() const;
+	Vec2 get_movement_vector() const;
 
 	// Misc
 	void follow_mouse();
@@ -54,15 +55,20 @@ private:
 	void key_pressed(int key) override;
 	void key_released(int key) override;
 
-	vector<PlayerParticle> player_particles_;
+	PlayerParticlePool player_particles_;
 
 	float movement_speed;
 	
 	bool mouse_down_;
 	int mouse_button_;
-	ofVec2f mouse_pos_;
+	Vec2 mouse_pos_;
 
 	bool aiming_boost_;
 	
 	bool player_following_mouse_;
+
+	bool gui_values_sent_; // initial values are sent to the gui_manager once, after which it updates them and the player reads them back
+
+	vector<GameObject*> pull_targets_; // collectables in pull range at the start of the step
+	GameObject pull_range_; // what pulled collectables collide with
 };
\ No newline at end of file
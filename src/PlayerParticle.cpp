@@ -1,54 +1,88 @@
 #include "PlayerParticle.h"
 
-PlayerParticle::PlayerParticle(ofVec2f _pos, ofVec2f _vel, float _radius, ofColor _color, int _lifetime)
+PlayerParticlePool::PlayerParticlePool()
+	:	next_(0)
+	,	count_(0)
 {
-	pos = _pos;
-	vel = _vel;
-	vel.x += ofRandom(-1.5, 1.5);
-	vel.y += ofRandom(-1.5, 1.5);
-	radius = _radius;
-	starting_radius = radius;
-	color = _color;
-	starting_alpha = _color.a;
-	alpha = starting_alpha;
-	lifetime = _lifetime;
-	starting_lifetime = lifetime;
+	for (int i = 0; i < PLAYER_PARTICLE_CAPACITY; i++)
+	{
+		lifetime_[i] = 0;
+	}
 }
 
-void PlayerParticle::update()
+void PlayerParticlePool::spawn(const ofVec2f pos, const ofVec2f vel, const float radius, const ofColor color, const int lifetime)
 {
-	friction = vel;
-	friction *= -1;
-	friction *= 0.015;
-	accel += (friction * 2);
-	accel.limit(0.15);
-
-	vel += accel;
-	accel.set(0);
+	const int i = next_;
+	next_ = (next_ + 1) % PLAYER_PARTICLE_CAPACITY;
 
-	ofVec2f newPos;
-	newPos.x = ofLerp(pos.x, pos.x + vel.x, 0.75);
-	newPos.y = ofLerp(pos.y, pos.y + vel.y, 0.75);
+	if (lifetime_[i] <= 0) count_++; // otherwise the oldest particle is overwritten
 
-	pos = newPos;
-	radius = ofMap(lifetime, 0, starting_lifetime, 0, starting_radius, true);
-	alpha = ofMap(lifetime, 0, starting_lifetime, 0, starting_alpha, true);
+	pos_x_[i] = pos.x;
+	pos_y_[i] = pos.y;
+	vel_x_[i] = vel.x + Random::get(RANDOM_PLAYER).range(-1.5f, 1.5f);
+	vel_y_[i] = vel.y + Random::get(RANDOM_PLAYER).range(-1.5f, 1.5f);
+	radius_[i] = radius;
+	starting_radius_[i] = radius;
+	alpha_[i] = color.a;
+	starting_alpha_[i] = color.a;
+	lifetime_[i] = max(lifetime, 1);
+	starting_lifetime_[i] = lifetime_[i];
+	color_[i] = color;
+}
 
-	if (lifetime > 0) {
-		lifetime--;
+void PlayerParticlePool::clear()
+{
+	for (int i = 0; i < PLAYER_PARTICLE_CAPACITY; i++)
+	{
+		lifetime_[i] = 0;
 	}
-	else {
-		needs_to_be_deleted = true;
+	count_ = 0;
+}
+
+void PlayerParticlePool::update()
+{
+	if (count_ == 0) return;
+
+	for (int i = 0; i < PLAYER_PARTICLE_CAPACITY; i++)
+	{
+		if (lifetime_[i] <= 0) continue;
+
+		// friction, limited to the same maximum acceleration as before
+		float accel_x = vel_x_[i] * -0.03f;
+		float accel_y = vel_y_[i] * -0.03f;
+		const float accel_length_sq = accel_x * accel_x + accel_y * accel_y;
+		if (accel_length_sq > 0.15f * 0.15f)
+		{
+			const float limit = 0.15f / sqrt(accel_length_sq);
+			accel_x *= limit;
+			accel_y *= limit;
+		}
+
+		vel_x_[i] += accel_x;
+		vel_y_[i] += accel_y;
+
+		pos_x_[i] += vel_x_[i] * 0.75f;
+		pos_y_[i] += vel_y_[i] * 0.75f;
+
+		const float life = static_cast<float>(lifetime_[i]) / starting_lifetime_[i];
+		radius_[i] = starting_radius_[i] * life;
+		alpha_[i] = starting_alpha_[i] * life;
+
+		lifetime_[i]--;
+		if (lifetime_[i] == 0) count_--;
 	}
 }
 
-void PlayerParticle::draw()
+void PlayerParticlePool::draw(BatchRenderer& batch) const
 {
-	ofSetColor(color, 50);
-	ofFill();
-	ofDrawEllipse(pos.x, pos.y, radius, radius);
-
-	ofSetColor(color, alpha);
-	ofNoFill();
-	ofDrawEllipse(pos.x, pos.y, radius, radius);
-}
\ No newline at end of file
+	if (count_ == 0) return;
+
+	for (int i = 0; i < PLAYER_PARTICLE_CAPACITY; i++)
+	{
+		if (lifetime_[i] <= 0) continue;
+
+		const Vec2 pos(pos_x_[i], pos_y_[i]);
+		batch.add_fill(pos, radius_[i], ofColor(color_[i], 50));
+		batch.add_outline(pos, radius_[i], 1, ofColor(color_[i], alpha_[i]));
+	}
+}
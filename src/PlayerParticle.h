@@ -1,31 +1,42 @@
 #pragma once
 
 #include "ofMain.h"
+#include "BatchRenderer.h"
+#include "core/Random.h"
 
-class PlayerParticle {
+#define PLAYER_PARTICLE_CAPACITY 128
+
+// fixed-capacity ring buffer of the player's local particle effects
+// particles are stored as parallel arrays and updated in one pass - when the buffer is full the oldest particle is overwritten
+class PlayerParticlePool {
 
 public:
 
-	PlayerParticle(ofVec2f _pos, ofVec2f _vel, float _radius, ofColor _color, int _lifetime);
+	PlayerParticlePool();
+
+	void spawn(ofVec2f pos, ofVec2f vel, float radius, ofColor color, int lifetime);
+	void clear();
 
 	void update();
-	void draw();
+	void draw(BatchRenderer& batch) const;
 
-	bool needs_to_be_deleted = false;
+	int get_count() const { return count_; }
 
 private:
 
-	ofVec2f pos;
-	ofVec2f vel;
-	ofVec2f accel;
-	float radius;
-	int starting_radius;
-	ofColor color;
-	int starting_alpha;
-	int alpha;
-
-	int lifetime;
-	int starting_lifetime;
-	ofVec2f friction;
-
-};
\ No newline at end of file
+	int next_;
+	int count_;
+
+	float pos_x_[PLAYER_PARTICLE_CAPACITY];
+	float pos_y_[PLAYER_PARTICLE_CAPACITY];
+	float vel_x_[PLAYER_PARTICLE_CAPACITY];
+	float vel_y_[PLAYER_PARTICLE_CAPACITY];
+	float radius_[PLAYER_PARTICLE_CAPACITY];
+	float starting_radius_[PLAYER_PARTICLE_CAPACITY];
+	float alpha_[PLAYER_PARTICLE_CAPACITY];
+	float starting_alpha_[PLAYER_PARTICLE_CAPACITY];
+	int lifetime_[PLAYER_PARTICLE_CAPACITY];
+	int starting_lifetime_[PLAYER_PARTICLE_CAPACITY];
+	ofColor color_[PLAYER_PARTICLE_CAPACITY];
+
+};
@@ -2,11 +2,15 @@
 
 PlayerTrail::PlayerTrail(const ofVec2f pos, const ofVec2f vel, const float radius, const ofColor color, const int lifetime)
 	:	pos_(pos),
-		vel_(ofVec2f(vel.x + ofRandom(-1.5f, 1.5f), vel.y + ofRandom(-1.5f, 1.5f))),
 		radius_(radius),
 		color_(color),
 		lifetime_(lifetime)
 {
+	// one draw per statement, so x always gets the first
+	RandomStream& random = Random::get(RANDOM_PLAYER);
+	const float jitter_x = random.range(-1.5f, 1.5f);
+	const float jitter_y = random.range(-1.5f, 1.5f);
+	vel_ = ofVec2f(vel.x + jitter_x, vel.y + jitter_y);
 }
 
 void PlayerTrail::update()
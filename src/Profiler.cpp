@@ -0,0 +1,354 @@
+#include "Profiler.h"
+
+atomic<bool> Profiler::enabled_(false);
+bool Profiler::view_enabled_ = false;
+mutex Profiler::buffers_mutex_;
+vector<unique_ptr<Profiler::ThreadBuffer>> Profiler::buffers_;
+thread_local Profiler::ThreadBuffer* Profiler::thread_buffer_ = nullptr;
+map<string, Profiler::ThreadBuffer*> Profiler::timelines_;
+vector<Profiler::ThreadTree> Profiler::trees_;
+float Profiler::frame_times_[PROFILER_FRAME_HISTORY] = {};
+int Profiler::frame_count_ = 0;
+bool Profiler::capturing_ = false;
+string Profiler::capture_path_;
+vector<Profiler::CapturedEvent> Profiler::capture_events_;
+vector<uint64_t> Profiler::capture_frames_;
+uint32_t Profiler::capture_dropped_ = 0;
+
+void Profiler::set_enabled(const bool enabled)
+{
+	view_enabled_ = enabled;
+	update_enabled();
+}
+
+void Profiler::update_enabled()
+{
+	enabled_.store(view_enabled_ || capturing_, memory_order_relaxed);
+}
+
+void Profiler::start_capture(const string& path)
+{
+	if (capturing_) return;
+
+	capture_path_ = path;
+	capture_events_.clear();
+	capture_frames_.clear();
+	capture_dropped_ = 0;
+	capturing_ = true;
+	update_enabled();
+
+	cout << "------------Profiler.cpp------------" << endl;
+	cout << " - Trace capture started" << endl;
+	cout << "------------------------------------" << endl;
+}
+
+void Profiler::stop_capture()
+{
+	if (!capturing_) return;
+
+	// pick up whatever finished since the last collect
+	{
+		lock_guard<mutex> lock(buffers_mutex_);
+		for (size_t i = 0; i < buffers_.size(); i++)
+		{
+			drain(i);
+		}
+	}
+
+	capturing_ = false;
+	update_enabled();
+
+	const bool saved = write_trace(capture_path_);
+
+	cout << "------------Profiler.cpp------------" << endl;
+	cout << ((saved) ? " - Trace saved to " : "Error: Couldn't save trace to ") << ofToDataPath(capture_path_) << endl;
+	cout << " - Frames: " << capture_frames_.size() << ", Events: " << capture_events_.size() << endl;
+	if (capture_dropped_ > 0) cout << " - Dropped: " << capture_dropped_ << endl;
+	cout << "------------------------------------" << endl;
+
+	capture_events_.clear();
+	capture_events_.shrink_to_fit();
+}
+
+bool Profiler::write_trace(const string& path)
+{
+	// streamed rather than built as a json object, a capture can hold millions of events
+	ofstream file(ofToDataPath(path));
+	if (!file.is_open()) return false;
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	bool first = true;
+	const auto separator = [&file, &first] {
+		if (!first) file << ",\n";
+		first = false;
+	};
+
+	{
+		lock_guard<mutex> lock(buffers_mutex_);
+		for (size_t i = 0; i < buffers_.size(); i++)
+		{
+			separator();
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"" << escape(buffers_[i]->name) << "\"}}";
+		}
+	}
+
+	for (const uint64_t frame : capture_frames_)
+	{
+		separator();
+		file << "{\"name\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":" << frame << "}";
+	}
+
+	for (auto& captured : capture_events_)
+	{
+		separator();
+		file << "{\"name\":\"" << escape(captured.event.name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << captured.thread << ",\"ts\":" << captured.event.start << ",\"dur\":" << captured.event.duration << "}";
+	}
+
+	file << "\n]}\n";
+	return file.good();
+}
+
+string Profiler::escape(const string& text)
+{
+	string escaped;
+	for (const char c : text)
+	{
+		if (c == '"' || c == '\\') escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+Profiler::ThreadBuffer& Profiler::get_thread_buffer()
+{
+	// registered on the thread's first scope, the lock is only ever taken here and in collect
+	if (thread_buffer_ == nullptr)
+	{
+		lock_guard<mutex> lock(buffers_mutex_);
+		buffers_.push_back(make_unique<ThreadBuffer>());
+		thread_buffer_ = buffers_.back().get();
+		thread_buffer_->name = "thread " + ofToString(buffers_.size());
+	}
+	return *thread_buffer_;
+}
+
+void Profiler::set_thread_name(const string& name)
+{
+	ThreadBuffer& buffer = get_thread_buffer();
+	lock_guard<mutex> lock(buffers_mutex_);
+	buffer.name = name;
+}
+
+uint32_t Profiler::get_path(const char* name, const uint32_t parent)
+{
+	// fnv-1a over the parent's path and the name
+	uint32_t path = 2166136261u ^ parent;
+	for (const char* c = name; *c != '\0'; c++)
+	{
+		path = (path ^ static_cast<uint8_t>(*c)) * 16777619u;
+	}
+	if (path == 0) path = 1; // 0 is the root
+	return path;
+}
+
+void Profiler::push(ThreadBuffer& buffer, const ProfileEvent& event)
+{
+	const uint32_t index = buffer.written.load(memory_order_relaxed);
+	buffer.events[index % PROFILER_RING_SIZE] = event;
+	buffer.written.store(index + 1, memory_order_release);
+}
+
+uint32_t Profiler::enter(const char* name, uint32_t& parent)
+{
+	ThreadBuffer& buffer = get_thread_buffer();
+	parent = buffer.current_path;
+	buffer.current_path = get_path(name, parent);
+	return buffer.current_path;
+}
+
+void Profiler::leave(const char* name, const uint32_t path, const uint32_t parent, const uint64_t start)
+{
+	ThreadBuffer& buffer = *thread_buffer_;
+	buffer.current_path = parent;
+	push(buffer, { name, path, parent, start, static_cast<uint32_t>(ofGetElapsedTimeMicros() - start) });
+}
+
+uint32_t Profiler::add_timeline_scope(const string& timeline, const char* name, const uint32_t parent, const uint64_t start, const uint32_t duration)
+{
+	auto found = timelines_.find(timeline);
+	if (found == timelines_.end())
+	{
+		lock_guard<mutex> lock(buffers_mutex_);
+		buffers_.push_back(make_unique<ThreadBuffer>());
+		buffers_.back()->name = timeline;
+		found = timelines_.emplace(timeline, buffers_.back().get()).first;
+	}
+
+	const uint32_t path = get_path(name, parent);
+	push(*found->second, { name, path, parent, start, duration });
+	return path;
+}
+
+void Profiler::collect(const float frame_time)
+{
+	lock_guard<mutex> lock(buffers_mutex_);
+
+	for (size_t i = 0; i < buffers_.size(); i++)
+	{
+		drain(i);
+
+		for (auto& node : trees_[i].nodes)
+		{
+			Node& n = node.second;
+			n.history[n.history_next] = n.frame_total / 1000.0f;
+			n.history_next = (n.history_next + 1) % PROFILER_HISTORY;
+			n.history_count = min(n.history_count + 1, PROFILER_HISTORY);
+			n.frame_total = 0;
+			n.calls = 0;
+		}
+	}
+
+	frame_times_[frame_count_ % PROFILER_FRAME_HISTORY] = frame_time;
+	frame_count_++;
+
+	if (capturing_) capture_frames_.push_back(ofGetElapsedTimeMicros());
+}
+
+// buffers_mutex_ must be held
+void Profiler::drain(const size_t index)
+{
+	if (index == trees_.size()) trees_.push_back({ buffers_[index].get() });
+
+	ThreadTree& tree = trees_[index];
+	ThreadBuffer& buffer = *tree.buffer;
+
+	// the producer writes slot written % size before publishing written + 1, so once written - read reaches the ring size the oldest slot may be half written
+	uint32_t written = buffer.written.load(memory_order_acquire);
+	if (written - buffer.read >= PROFILER_RING_SIZE)
+	{
+		buffer.dropped += written - buffer.read - PROFILER_RING_SIZE + 1;
+		buffer.read = written - PROFILER_RING_SIZE + 1;
+	}
+
+	for (; buffer.read != written; buffer.read++)
+	{
+		const ProfileEvent event = buffer.events[buffer.read % PROFILER_RING_SIZE];
+
+		// the producer may have lapped us while we copied - that slot can't be trusted
+		atomic_thread_fence(memory_order_acquire);
+		written = buffer.written.load(memory_order_relaxed);
+		if (written - buffer.read >= PROFILER_RING_SIZE)
+		{
+			buffer.dropped++;
+			continue;
+		}
+
+		auto found = tree.nodes.find(event.path);
+		if (found == tree.nodes.end())
+		{
+			found = tree.nodes.emplace(event.path, Node{ event.name, event.parent }).first;
+			tree.order.push_back(event.path);
+		}
+		found->second.frame_total += event.duration;
+		found->second.calls++;
+
+		if (capturing_)
+		{
+			if (capture_events_.size() < PROFILER_CAPTURE_LIMIT) capture_events_.push_back({ static_cast<int>(index), event });
+			else capture_dropped_++;
+		}
+	}
+}
+
+void Profiler::draw(const float x, const float y)
+{
+	lock_guard<mutex> lock(buffers_mutex_);
+
+	ofPushStyle();
+	ofSetColor(255);
+
+	float row_y = y;
+	ofDrawBitmapString("scope                               avg     p50     p99 (ms)", x, row_y);
+	row_y += 16;
+
+	for (auto& tree : trees_)
+	{
+		ofSetColor(255, 160, 40);
+		ofDrawBitmapString(tree.buffer->name + ((tree.buffer->dropped > 0) ? " (" + ofToString(tree.buffer->dropped) + " dropped)" : ""), x, row_y);
+		row_y += 14;
+
+		for (const uint32_t path : tree.order)
+		{
+			if (tree.nodes.at(path).parent == 0) draw_node(tree, path, 1, x, row_y);
+		}
+		row_y += 4;
+	}
+
+	draw_histogram(x, row_y + 8);
+
+	ofPopStyle();
+}
+
+void Profiler::draw_node(const ThreadTree& tree, const uint32_t path, const int depth, const float x, float& y)
+{
+	const Node& node = tree.nodes.at(path);
+
+	vector<float> history(node.history, node.history + node.history_count);
+	sort(history.begin(), history.end());
+
+	float average = 0;
+	for (const float ms : history)
+	{
+		average += ms;
+	}
+	if (!history.empty()) average /= history.size();
+
+	const float p50 = history.empty() ? 0 : history[(history.size() - 1) / 2];
+	const float p99 = history.empty() ? 0 : history[min(history.size() - 1, static_cast<size_t>(ceil(history.size() * 0.99f)) - 1)];
+
+	string label = string(depth * 2, ' ') + node.name;
+	label.resize(max(label.size(), static_cast<size_t>(34)), ' ');
+
+	ofSetColor(200);
+	ofDrawBitmapString(label + " " + ofToString(average, 3, 7, ' ') + " " + ofToString(p50, 3, 7, ' ') + " " + ofToString(p99, 3, 7, ' '), x, y);
+	y += 14;
+
+	for (const uint32_t child : tree.order)
+	{
+		if (tree.nodes.at(child).parent == path) draw_node(tree, child, depth + 1, x, y);
+	}
+}
+
+void Profiler::draw_histogram(const float x, const float y)
+{
+	// frame times in 2ms bins, the last bin catches everything slower
+	const int bin_count = 25;
+	const float bin_ms = 2;
+	const float bar_width = 12;
+	const float height = 60;
+
+	int bins[bin_count] = {};
+	const int count = min(frame_count_, PROFILER_FRAME_HISTORY);
+	for (int i = 0; i < count; i++)
+	{
+		bins[min(static_cast<int>(frame_times_[i] / bin_ms), bin_count - 1)]++;
+	}
+
+	int tallest = 1;
+	for (const int bin : bins)
+	{
+		tallest = max(tallest, bin);
+	}
+
+	ofSetColor(255);
+	ofDrawBitmapString("frame time (last " + ofToString(count) + " frames, 0 - " + ofToString(bin_count * bin_ms, 0) + "ms)", x, y);
+
+	ofFill();
+	for (int i = 0; i < bin_count; i++)
+	{
+		const float bar_height = height * bins[i] / tallest;
+		ofSetColor((i * bin_ms < 1000.0f / 60.0f) ? ofColor(120, 200, 120) : ofColor(255, 120, 80));
+		ofDrawRectangle(x + i * bar_width, y + 8 + height - bar_height, bar_width - 2, bar_height);
+	}
+}
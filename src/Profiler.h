@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "ofMain.h"
+
+#define PROFILER_RING_SIZE		8192	// scopes a thread can record between two collects before the oldest are dropped
+#define PROFILER_HISTORY		120		// frames of history per scope
+#define PROFILER_FRAME_HISTORY	240		// frames in the frame time histogram
+#define PROFILER_CAPTURE_LIMIT	4000000	// events kept by one trace capture
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// times the rest of the enclosing block - name must be a string literal (or otherwise outlive the profiler)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+
+// one finished scope - path identifies the scope by its chain of enclosing scopes, so the same name under different parents stays separate
+struct ProfileEvent {
+	const char* name;
+	uint32_t path;
+	uint32_t parent;
+	uint64_t start;		// microseconds since the app started
+	uint32_t duration;	// microseconds
+};
+
+// hierarchical scope timings, shown as a tree in the perf panel
+// every thread records finished scopes into its own ring buffer (single producer, no locks), the main thread collects them once a frame
+// a trace capture keeps every collected scope and writes them out in the chrome trace event format (chrome://tracing, perfetto)
+// scopes are recorded while the view is open or a capture is running - otherwise a scope costs one relaxed atomic load
+class Profiler {
+
+public:
+
+	// whether the view is open
+	static void set_enabled(bool enabled);
+	static bool is_enabled()					{ return enabled_.load(memory_order_relaxed); }
+
+	// main thread - stop writes every scope collected since start to path
+	static void start_capture(const string& path);
+	static void stop_capture();
+	static bool is_capturing()					{ return capturing_; }
+
+	// label for the calling thread's tree
+	static void set_thread_name(const string& name);
+
+	// main thread, once per frame
+	static void collect(float frame_time);
+
+	// tree of every thread's scopes (avg / p50 / p99 over the last PROFILER_HISTORY frames) and a frame time histogram
+	static void draw(float x, float y);
+
+	// called by ProfileScope
+	static uint32_t enter(const char* name, uint32_t& parent);
+	static void leave(const char* name, uint32_t path, uint32_t parent, uint64_t start);
+
+	// a scope timed somewhere other than on a cpu thread (the gpu), shown and exported as a timeline of its own
+	// parents are added before their children, parent is the path returned for it (0 for the root) - main thread only
+	static uint32_t add_timeline_scope(const string& timeline, const char* name, uint32_t parent, uint64_t start, uint32_t duration);
+
+private:
+
+	struct ThreadBuffer {
+		string name;
+		ProfileEvent events[PROFILER_RING_SIZE];
+		atomic<uint32_t> written{ 0 };	// only the owning thread writes
+		uint32_t read = 0;				// only the collecting thread reads
+		uint32_t dropped = 0;
+		uint32_t current_path = 0;		// owning thread's innermost open scope
+	};
+
+	struct Node {
+		const char* name;
+		uint32_t parent;
+		uint64_t frame_total = 0;		// microseconds this frame
+		int calls = 0;
+		float history[PROFILER_HISTORY] = {};
+		int history_count = 0;
+		int history_next = 0;
+	};
+
+	struct ThreadTree {
+		ThreadBuffer* buffer;
+		map<uint32_t, Node> nodes;
+		vector<uint32_t> order;			// first seen first
+	};
+
+	struct CapturedEvent {
+		int thread;
+		ProfileEvent event;
+	};
+
+	static void update_enabled();
+	static void drain(size_t index);
+	static bool write_trace(const string& path);
+	static string escape(const string& text);
+
+	static ThreadBuffer& get_thread_buffer();
+	static uint32_t get_path(const char* name, uint32_t parent);
+	static void push(ThreadBuffer& buffer, const ProfileEvent& event);
+	static void draw_node(const ThreadTree& tree, uint32_t path, int depth, float x, float& y);
+	static void draw_histogram(float x, float y);
+
+	static atomic<bool> enabled_;	// view open or capturing
+	static bool view_enabled_;
+
+	static mutex buffers_mutex_;
+	static vector<unique_ptr<ThreadBuffer>> buffers_;
+	static thread_local ThreadBuffer* thread_buffer_;
+	static map<string, ThreadBuffer*> timelines_;
+
+	// collecting thread only
+	static vector<ThreadTree> trees_;
+	static float frame_times_[PROFILER_FRAME_HISTORY];
+	static int frame_count_;
+
+	static bool capturing_;
+	static string capture_path_;
+	static vector<CapturedEvent> capture_events_;
+	static vector<uint64_t> capture_frames_;	// frame boundaries
+	static uint32_t capture_dropped_;
+
+};
+
+class ProfileScope {
+
+public:
+
+	explicit ProfileScope(const char* name)
+		:	name_(name)
+		,	active_(Profiler::is_enabled())
+		,	start_(0)
+		,	path_(0)
+		,	parent_(0)
+	{
+		if (active_)
+		{
+			path_ = Profiler::enter(name_, parent_);
+			start_ = ofGetElapsedTimeMicros();
+		}
+	}
+
+	~ProfileScope()
+	{
+		if (active_) Profiler::leave(name_, path_, parent_, start_);
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+
+	const char* name_;
+	bool active_;
+	uint64_t start_;
+	uint32_t path_;
+	uint32_t parent_;
+
+};
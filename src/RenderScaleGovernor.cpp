@@ -0,0 +1,87 @@
+#include "RenderScaleGovernor.h"
+
+RenderScaleGovernor::RenderScaleGovernor()
+	:	enabled_(true)
+	,	drawing_offscreen_(false)
+	,	render_scale_(RENDER_SCALE_MAX)
+	,	average_frame_time_(1000.0f / 60.0f)
+	,	target_frame_time_(1000.0f / 60.0f * 1.1f)
+	,	headroom_frame_time_(1000.0f / 60.0f * 1.03f) // vsync is on, so a frame that makes it in time is never much below 16.7ms
+	,	slow_frames_(0)
+	,	fast_frames_(0)
+	,	frames_before_increase_(120)
+	,	frames_since_change_(0)
+{
+}
+
+void RenderScaleGovernor::update(const float frame_time)
+{
+	// smoothed frame time in ms
+	average_frame_time_ = ofLerp(average_frame_time_, frame_time * 1000.0f, 0.1f);
+	frames_since_change_++;
+
+	if (!enabled_) return;
+
+	if (average_frame_time_ > target_frame_time_)
+	{
+		slow_frames_++;
+		fast_frames_ = 0;
+	}
+	else if (average_frame_time_ < headroom_frame_time_)
+	{
+		fast_frames_++;
+		slow_frames_ = 0;
+	}
+
+	if (slow_frames_ >= 15 && render_scale_ > RENDER_SCALE_MIN)
+	{
+		// stepping up didn't hold - wait longer before trying again
+		if (frames_since_change_ < 60) frames_before_increase_ = min(frames_before_increase_ * 2, 3600);
+
+		render_scale_ = max(render_scale_ - RENDER_SCALE_STEP, RENDER_SCALE_MIN);
+		slow_frames_ = 0;
+		frames_since_change_ = 0;
+	}
+	else if (fast_frames_ >= frames_before_increase_ && render_scale_ < RENDER_SCALE_MAX)
+	{
+		render_scale_ = min(render_scale_ + RENDER_SCALE_STEP, RENDER_SCALE_MAX);
+		fast_frames_ = 0;
+		frames_since_change_ = 0;
+	}
+}
+
+void RenderScaleGovernor::begin()
+{
+	drawing_offscreen_ = get_render_scale() < RENDER_SCALE_MAX;
+	if (!drawing_offscreen_) return;
+
+	const int width = static_cast<int>(round(ofGetWidth() * get_render_scale()));
+	const int height = static_cast<int>(round(ofGetHeight() * get_render_scale()));
+	if (!target_.isAllocated() || target_.getWidth() != width || target_.getHeight() != height)
+	{
+		target_.allocate(width, height, GL_RGBA);
+	}
+
+	target_.begin();
+	ofClear(0, 255);
+}
+
+void RenderScaleGovernor::end()
+{
+	if (drawing_offscreen_) target_.end();
+}
+
+void RenderScaleGovernor::draw() const
+{
+	// upscale the world pass to the window, the gui is drawn after this at native resolution
+	if (drawing_offscreen_) target_.draw(0, 0, ofGetWidth(), ofGetHeight());
+}
+
+void RenderScaleGovernor::set_enabled(const bool enabled)
+{
+	if (enabled == enabled_) return;
+
+	enabled_ = enabled;
+	slow_frames_ = 0;
+	fast_frames_ = 0;
+}
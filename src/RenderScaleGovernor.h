@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ofMain.h"
+
+#define RENDER_SCALE_MIN		0.5f
+#define RENDER_SCALE_MAX		1.0f
+#define RENDER_SCALE_STEP		0.1f
+
+// renders the world pass into an offscreen target whose resolution follows the measured frame time
+// drops the scale quickly when frames run long and only creeps back up after a sustained run of fast frames - every failed step back up doubles the wait before the next attempt
+class RenderScaleGovernor {
+
+public:
+
+	RenderScaleGovernor();
+
+	void update(float frame_time);
+
+	void begin();
+	void end();
+	void draw() const;
+
+	void set_enabled(bool enabled);
+	bool get_enabled() const		{ return enabled_; }
+
+	float get_render_scale() const	{ return (enabled_) ? render_scale_ : 1; }
+	float get_average_frame_time() const { return average_frame_time_; }
+
+private:
+
+	ofFbo target_;
+
+	bool enabled_;
+	bool drawing_offscreen_;
+	float render_scale_;
+	float average_frame_time_;
+
+	float target_frame_time_;	// frames slower than this push the scale down
+	float headroom_frame_time_;	// frames faster than this let it back up
+
+	int slow_frames_;
+	int fast_frames_;
+	int frames_before_increase_;
+	int frames_since_change_;
+
+};
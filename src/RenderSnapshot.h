@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ofMain.h"
+#include "BatchRenderer.h"
+
+// fluid particles as they should be drawn this frame - either packed line vertices or, zoomed out, a splatted density image
+struct ParticleSnapshot {
+	bool visible = false;
+	bool splat = false;
+
+	int line_count = 0;
+	vector<float> positions;	// 2 vertices per line, x/y
+	vector<float> colors;		// 2 vertices per line, rgb
+
+	int splat_width = 0;
+	int splat_height = 0;
+	vector<unsigned char> splat_pixels;
+};
+
+// the fluid visualisation image, rgba, built from the solver on the simulation thread
+struct FluidSnapshot {
+	bool visible = false;
+	bool has_image = false;		// false when the draw mode has to go through the drawer (vectors)
+	int width = 0;
+	int height = 0;
+	vector<unsigned char> pixels;
+};
+
+// everything the render thread needs to draw a simulated frame, it never reads live simulation state
+// snapshots are recycled through a triple buffer, so the vectors keep their capacity from frame to frame
+struct RenderSnapshot {
+	uint64_t frame = 0;
+
+	BatchList entities;
+	FluidSnapshot fluid;
+	ParticleSnapshot particles;
+};
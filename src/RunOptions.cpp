@@ -0,0 +1,81 @@
+#include "RunOptions.h"
+
+RunOptions RunOptions::parse(const int argc, char* argv[])
+{
+	RunOptions options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const string arg = argv[i];
+		const bool has_value = i + 1 < argc;
+
+		if (arg == "--headless")
+		{
+			options.headless = true;
+		}
+		else if (arg == "--scene" && has_value)
+		{
+			options.scene = argv[++i];
+		}
+		else if (arg == "--frames" && has_value)
+		{
+			options.frames = max(1, ofToInt(argv[++i]));
+		}
+		else if (arg == "--seed" && has_value)
+		{
+			options.seed = ofToInt(argv[++i]);
+		}
+		else if (arg == "--threads" && has_value)
+		{
+			options.threads = ofToInt(argv[++i]);
+		}
+		else if (arg == "--benchmark")
+		{
+			options.benchmark = true;
+			options.headless = true;
+			if (has_value && string(argv[i + 1]).find("--") != 0) options.benchmark_output = argv[++i];
+		}
+		else if (arg == "--trace" && i + 2 < argc)
+		{
+			options.trace_first_frame = max(0, ofToInt(argv[++i]));
+			options.trace_frame_count = max(1, ofToInt(argv[++i]));
+			if (i + 1 < argc && string(argv[i + 1]).find("--") != 0) options.trace_output = argv[++i];
+		}
+		else if (arg == "--spike-threshold" && has_value)
+		{
+			options.spike_threshold = max(1.0f, ofToFloat(argv[++i]));
+		}
+		else if (arg == "--strict-alloc")
+		{
+			options.strict_allocations = true;
+		}
+		else if (arg == "--record" && has_value)
+		{
+			options.record_path = argv[++i];
+		}
+		else if (arg == "--replay" && has_value)
+		{
+			options.replay_path = argv[++i];
+		}
+		else if (arg == "--batch-eval" && has_value)
+		{
+			options.batch_eval_count = max(1, ofToInt(argv[++i]));
+			options.headless = true;
+			if (i + 1 < argc && string(argv[i + 1]).find("--") != 0) options.batch_eval_output = argv[++i];
+		}
+		else if (arg == "--microbench")
+		{
+			options.microbench = true;
+			options.headless = true;
+		}
+		else
+		{
+			cout << "Error: Unknown argument '" << arg << "'" << endl;
+		}
+	}
+
+	// benchmark runs need to be comparable
+	if ((options.benchmark || options.microbench || options.batch_eval_count > 0) && options.seed < 0) options.seed = 1;
+
+	return options;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ofMain.h"
+
+// command line options
+// iota --headless --scene Scenes/menu_scene.xml --frames 600 --seed 1 --threads 4
+// iota --benchmark [output.json] --frames 600
+// iota --microbench
+// iota --batch-eval 5000 [batch_eval.json] --frames 1200 --threads 16
+// iota --trace 300 120 [trace.json]
+// iota --spike-threshold 33
+// iota --strict-alloc
+// iota --record session.iotj, iota --replay session.iotj [--headless]
+struct RunOptions {
+
+	bool headless = false;						// no window or GL context, steps the simulation as fast as it can then exits
+	string scene = "Scenes/menu_scene.xml";
+	int frames = 600;							// headless only
+	int seed = -1;								// < 0 leaves the generator unseeded
+	int threads = -1;							// job pool workers, < 0 picks from the hardware thread count
+
+	bool benchmark = false;						// headless replay of every scene plus generated stress scenes, timings are written to benchmark_output
+	string benchmark_output = "benchmark.json";
+
+	bool microbench = false;					// headless timings of the individual hot kernels, then exits
+
+	int batch_eval_count = 0;					// > 0 evaluates that many procedural scenes in parallel worlds (one per thread), results go to batch_eval_output
+	string batch_eval_output = "batch_eval.json";
+
+	int trace_first_frame = -1;					// >= 0 captures a chrome trace of trace_frame_count frames starting here
+	int trace_frame_count = 0;
+	string trace_output = "trace.json";
+
+	bool strict_allocations = false;			// flags every heap allocation once a frame should be in a steady state
+
+	string record_path;							// writes the session's input (and its seed and scene) to an input journal
+	string replay_path;							// plays an input journal back - its seed and scene replace --seed and --scene, headless runs its frame count
+
+	float spike_threshold = 50;					// ms - longer frames dump the flight recorder, adjustable in the perf panel
+
+	static RunOptions parse(int argc, char* argv[]);
+
+};
@@ -46,41 +46,27 @@ void SceneManager::update()
 		load_blank_scene();
 		gamemode_manager_->set_request_for_blank_scene(false);
 	}
-	else if (gui_manager_->gui_scene_new)
-	{
-		if (gui_manager_->get_request_new_scene()) {
-			gui_manager_->toggle_new_scene();
-			load_blank_scene();
-		}
+	else if (gui_manager_->get_request_new_scene()) {
+		gui_manager_->set_request_new_scene(false);
+		load_blank_scene();
 	}
-	else if (gui_manager_->gui_scene_save)
-	{
-		if (gui_manager_->get_request_save_scene()) {
-			gui_manager_->toggle_save_scene();
-			save_scene("Scenes/saved_scene");
-		}
+	else if (gui_manager_->get_request_save_scene()) {
+		gui_manager_->set_request_save_scene(false);
+		save_scene("Scenes/saved_scene");
 	}
-	else if (gui_manager_->gui_scene_quickload)
-	{
-		if (gui_manager_->get_request_quickload_scene()) {
-			gui_manager_->toggle_quickload_scene();
-			load_scene("Scenes/saved_scene.xml");
-		}
+	else if (gui_manager_->get_request_quickload_scene()) {
+		gui_manager_->set_request_quickload_scene(false);
+		load_scene("Scenes/saved_scene.xml");
 	}
-	else if (gui_manager_->gui_scene_load)
-	{
-		if (gui_manager_->get_request_load_scene()) {
-			gui_manager_->toggle_load_scene();
-			load_scene_dialogue();
-		}
+	else if (gui_manager_->get_request_load_scene()) {
+		gui_manager_->set_request_load_scene(false);
+		load_scene_dialogue();
 	}
 	
 	if (gamemode_manager_->get_current_mode_string() == "Main" || gamemode_manager_->get_current_mode_string() == "Procedural")
 	{
 		if (entity_manager_->get_point_count() == Collectable::get_points_collected())
 		{
-			static bool trig = false;
-
 			if (enter_pressed_)
 			{
 				if (gamemode_manager_->get_current_mode_string() == "Main")
@@ -97,11 +83,11 @@ void SceneManager::update()
 				cam_->set_zoom_mode(Camera::player_view);
 
 				enter_pressed_ = false;
-				trig = false;
+				level_complete_shown_ = false;
 			}
 			else
 			{
-				if (!trig)
+				if (!level_complete_shown_)
 				{
 					// zoom out to view the completed level
 					cam_->set_zoom_mode(Camera::map_view);
@@ -109,7 +95,7 @@ void SceneManager::update()
 					// play level complete queue
 					audio_manager_->event_level_complete();
 
-					trig = true;
+					level_complete_shown_ = true;
 				}
 			}
 		}
@@ -123,6 +109,7 @@ void SceneManager::update()
 
 void SceneManager::save_scene(const string scene_name)
 {	
+	FlightRecorder::mark("scene save " + scene_name);
 	cout << "------------SceneManager.cpp------------" << endl;
 
 	xml1_.popTag();
@@ -224,14 +211,23 @@ void SceneManager::load_scene_dialogue()
 
 void SceneManager::load_scene(const string path)
 {
+	PROFILE_SCOPE("scene load");
+	FlightRecorder::mark("scene load " + path);
+	AllocationTracker::restart_warmup();
 	get_ready_for_new_scene();
 
-	if (xml_.loadFile(path)) {
+	const bool preloaded = !preloaded_path_.empty() && path == preloaded_path_;
+	preloaded_path_.clear();
+
+	if (preloaded || xml_.loadFile(path)) {
 		xml_.pushTag("Scene");
 
-		cout << "------------SceneManager.cpp------------" << endl;
-		cout << " [ Scene Loaded ]" << endl;
-		cout << " - Scene Name: " << xml_.getValue("name", "N/A") << endl;
+		if (!quiet_)
+		{
+			cout << "------------SceneManager.cpp------------" << endl;
+			cout << " [ Scene Loaded ]" << endl;
+			cout << " - Scene Name: " << xml_.getValue("name", "N/A") << endl;
+		}
 
 		const int fluid_count = xml_.getNumTags("Fluid");
 		for (int i = 0; i < fluid_count; i++) {
@@ -257,7 +253,7 @@ void SceneManager::load_scene(const string path)
 			fluid_manager_->get_solver()->setWrap(w, w);
 			gui_manager_->gui_fluid_wrap_edges = w;
 			
-			cout << "- Fluid Mode: " << xml_.getValue("mode", -1) << endl;
+			if (!quiet_) cout << "- Fluid Mode: " << xml_.getValue("mode", -1) << endl;
 			xml_.popTag();
 		}
 		int count = 0;
@@ -276,9 +272,7 @@ void SceneManager::load_scene(const string path)
 			// Player properties
 			if (type == "Player")
 			{
-				GameObject* player = new Player();
-				player->init(entity_manager_->get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
-				entity_manager_->add_game_object(player);
+				entity_manager_->spawn<Player>();
 			}
 			// Mass properties
 			else if (type == "Mass")
@@ -286,9 +280,7 @@ void SceneManager::load_scene(const string path)
 				const float mass = xml_.getValue("mass", -1);
 				const float radius = xml_.getValue("radius", -1);
 
-				GameObject* object = new Mass(pos, mass, radius);
-				object->init(entity_manager_->get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
-				entity_manager_->add_game_object(object);
+				entity_manager_->spawn<Mass>(pos, mass, radius);
 			}
 			// Spring properties
 			else if (type == "Spring")
@@ -308,9 +300,7 @@ void SceneManager::load_scene(const string path)
 					radiuses.push_back(xml_.getValue("radius" + to_string(i + 1), -1));
 				}							
 				
-				GameObject* spring = new Spring(pos, radiuses, masses, k, damping, springmass);
-				spring->init(entity_manager_->get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
-				entity_manager_->add_game_object(spring);
+				entity_manager_->spawn<Spring>(pos, radiuses, masses, k, damping, springmass);
 			}
 			// Collectable properties
 			else if (type == "Collectable")
@@ -322,21 +312,28 @@ void SceneManager::load_scene(const string path)
 				const double emission_force = xml_.getValue("emission_force", -1.0f);
 				const bool is_active = xml_.getValue("is_active", false);
 				
-				GameObject* point = new Collectable(pos, mass, radius, emission_frequency, emission_force, is_active);
-				point->init(entity_manager_->get_game_objects(), game_controller_, gui_manager_, cam_, fluid_manager_, audio_manager_, gamemode_manager_);
+				entity_manager_->spawn<Collectable>(pos, mass, radius, emission_frequency, emission_force, is_active);
 				gui_manager_->set_max_point_count(gui_manager_->get_max_point_count() + 1);
-				entity_manager_->add_game_object(point);
 			}
 
 			xml_.popTag();
 		}
 
-		cout << " - GameObject count: " << count << endl;
-		cout << "----------------------------------------" << endl;
+		if (!quiet_)
+		{
+			cout << " - GameObject count: " << count << endl;
+			cout << "----------------------------------------" << endl;
+		}
 
 	}
 }
 
+void SceneManager::preload_scene(const string& path)
+{
+	PROFILE_SCOPE("scene parse");
+	preloaded_path_ = xml_.loadFile(path) ? path : "";
+}
+
 void SceneManager::load_next_scene_in_sequence()
 {
 	current_scene_++;
@@ -420,25 +417,36 @@ void SceneManager::load_procedural_scene() const
 
 	entity_manager_->create_entity("Player");
 	
-	for (int i = 0; i < ofRandom(3, 7); i++)
+	// coordinates drawn one statement at a time, argument evaluation order isn't fixed
+	RandomStream& random = Random::get(RANDOM_SCENE);
+	for (int i = 0; i < random.range(3, 7); i++)
 	{
-		const ofVec2f pos = ofVec2f(ofRandom(static_cast<float>(-WORLD_WIDTH) / 2, static_cast<float>(WORLD_WIDTH) / 2), ofRandom(static_cast<float>(-WORLD_HEIGHT) / 2, static_cast<float>(WORLD_HEIGHT) / 2));
+		const float x = random.range(static_cast<float>(-world::WORLD_WIDTH) / 2, static_cast<float>(world::WORLD_WIDTH) / 2);
+		const float y = random.range(static_cast<float>(-world::WORLD_HEIGHT) / 2, static_cast<float>(world::WORLD_HEIGHT) / 2);
+		const ofVec2f pos = ofVec2f(x, y);
 		entity_manager_->create_entity("Collectable", pos);
 	}
-	for (int i = 0; i < ofRandom(1, 3); i++)
+	for (int i = 0; i < random.range(1, 3); i++)
 	{
-		const ofVec2f pos = ofVec2f(ofRandom(static_cast<float>(-WORLD_WIDTH) / 2, static_cast<float>(WORLD_WIDTH) / 2), ofRandom(static_cast<float>(-WORLD_HEIGHT) / 2, static_cast<float>(WORLD_HEIGHT) / 2));
+		const float x = random.range(static_cast<float>(-world::WORLD_WIDTH) / 2, static_cast<float>(world::WORLD_WIDTH) / 2);
+		const float y = random.range(static_cast<float>(-world::WORLD_HEIGHT) / 2, static_cast<float>(world::WORLD_HEIGHT) / 2);
+		const ofVec2f pos = ofVec2f(x, y);
 		entity_manager_->create_entity("Mass", pos);
 	}
-	for (int i = 0; i < ofRandom(1, 3); i++)
+	for (int i = 0; i < random.range(1, 3); i++)
 	{
-		const ofVec2f pos = ofVec2f(ofRandom(static_cast<float>(-WORLD_WIDTH) / 2, static_cast<float>(WORLD_WIDTH) / 2), ofRandom(static_cast<float>(-WORLD_HEIGHT) / 2, static_cast<float>(WORLD_HEIGHT) / 2));
+		const float x = random.range(static_cast<float>(-world::WORLD_WIDTH) / 2, static_cast<float>(world::WORLD_WIDTH) / 2);
+		const float y = random.range(static_cast<float>(-world::WORLD_HEIGHT) / 2, static_cast<float>(world::WORLD_HEIGHT) / 2);
+		const ofVec2f pos = ofVec2f(x, y);
 		entity_manager_->create_entity("Spring", pos);
 	}
 
-	cout << "------------SceneManager.cpp------------" << endl;
-	cout << " - New Procedural Level Loaded" << endl;
-	cout << "----------------------------------------" << endl;
+	if (!quiet_)
+	{
+		cout << "------------SceneManager.cpp------------" << endl;
+		cout << " - New Procedural Level Loaded" << endl;
+		cout << "----------------------------------------" << endl;
+	}
 }
 
 void SceneManager::load_blank_scene()
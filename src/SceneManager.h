@@ -19,9 +19,12 @@ public:
 
 		void load_scene_dialogue();
 		void load_scene(string path);	
+		void preload_scene(const string& path); // parses the file only, safe on a worker while nothing else touches the scene manager - load_scene(path) picks it up
 		void load_next_scene_in_sequence();
 		void load_procedural_scene() const;
 		void load_blank_scene();
+
+		void set_quiet(const bool quiet) { quiet_ = quiet; } // no per-scene log, batch worlds load thousands of scenes
 	
 		void destroy_current_scene() const;
 		void reset_fluid() const;
@@ -43,9 +46,12 @@ private:
 
 		ofxXmlSettings xml_;
 		ofxXmlSettings xml1_;
+		string preloaded_path_; // already parsed into xml_
 
 		int current_scene_;
 	
 		bool enter_pressed_{};
+		bool level_complete_shown_{}; // the completed level has been zoomed out to and its cue played
+		bool quiet_{};
 	
 };
\ No newline at end of file
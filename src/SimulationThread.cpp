@@ -0,0 +1,80 @@
+#include "SimulationThread.h"
+
+SimulationThread::SimulationThread()
+	:	step_requested_(false)
+	,	stopping_(false)
+	,	step_time_(0)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+	stop();
+}
+
+void SimulationThread::setup(function<void(RenderSnapshot&)> step)
+{
+	step_ = move(step);
+}
+
+void SimulationThread::start()
+{
+	if (isThreadRunning() || !step_) return;
+
+	stopping_ = false;
+	startThread();
+
+	cout << "------------SimulationThread.cpp------------" << endl;
+	cout << " - Simulation running on its own thread" << endl;
+	cout << "--------------------------------------------" << endl;
+}
+
+void SimulationThread::stop()
+{
+	if (!isThreadRunning()) return;
+
+	{
+		lock_guard<std::mutex> lock(request_mutex_);
+		stopping_ = true;
+	}
+	request_condition_.notify_one();
+	waitForThread(true);
+}
+
+void SimulationThread::request_step()
+{
+	{
+		lock_guard<std::mutex> lock(request_mutex_);
+		step_requested_ = true;
+	}
+	request_condition_.notify_one();
+}
+
+bool SimulationThread::update_snapshot()
+{
+	return snapshots_.update();
+}
+
+void SimulationThread::threadedFunction()
+{
+	Profiler::set_thread_name("simulation");
+	AllocationTracker::set_tag(AllocationTracker::register_tag("simulation"));
+
+	while (isThreadRunning())
+	{
+		{
+			unique_lock<std::mutex> lock(request_mutex_);
+			request_condition_.wait(lock, [this] { return step_requested_ || stopping_; });
+			if (stopping_) break;
+			step_requested_ = false;
+		}
+
+		const uint64_t start = ofGetElapsedTimeMicros();
+		{
+			lock_guard<std::mutex> lock(simulation_mutex_);
+			step_(snapshots_.get_write_buffer());
+		}
+		snapshots_.publish();
+		step_time_ = (ofGetElapsedTimeMicros() - start) / 1000.0f;
+	}
+}
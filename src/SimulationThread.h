@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include "ofMain.h"
+#include "AllocationTracker.h"
+#include "Profiler.h"
+#include "RenderSnapshot.h"
+#include "core/TripleBuffer.h"
+
+// runs one simulation step per rendered frame on its own thread, overlapping with the render of the previous frame
+// every step fills a render snapshot that's handed to the render thread through a triple buffer
+// anything that touches simulation state from another thread (input, scene loading, gui) must hold the simulation mutex
+class SimulationThread : public ofThread {
+
+public:
+
+	SimulationThread();
+	~SimulationThread();
+
+	// 'step' is called on the simulation thread with the simulation mutex held
+	void setup(function<void(RenderSnapshot&)> step);
+	void start();
+	void stop();
+
+	// render thread
+	void request_step();
+	bool update_snapshot();
+	const RenderSnapshot& get_snapshot() const		{ return snapshots_.get_read_buffer(); }
+
+	std::mutex& get_simulation_mutex()					{ return simulation_mutex_; }
+	float get_step_time() const						{ return step_time_; }
+
+private:
+
+	void threadedFunction() override;
+
+	function<void(RenderSnapshot&)> step_;
+
+	std::mutex simulation_mutex_;
+
+	std::mutex request_mutex_;
+	condition_variable request_condition_;
+	bool step_requested_;
+	bool stopping_;
+
+	TripleBuffer<RenderSnapshot> snapshots_;
+	atomic<float> step_time_;	// ms
+
+};
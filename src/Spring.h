@@ -2,9 +2,10 @@
 
 #include "ofMain.h"
 #include "GameObject.h"
+#include "core/SpringChain.h"
 
 class Spring : public GameObject {
-	
+
 public:
 
 	Spring(ofVec2f anchor_pos, vector<float> node_radiuses, vector<float> node_masses, float k, float damping, float springmass);
@@ -15,18 +16,13 @@ private:
 
 	// Physics/spring calculations
 	void update_forces();
-	void apply_all_forces();
-	ofVec2f get_fluid_force(int node);
-	ofVec2f get_spring_force(int node);
-	void add_forces();
 	void reset_forces();
 
 	void drag_nodes();
-	void create_node(ofVec2f node_pos, ofVec2f node_vel, ofVec2f node_accel, float node_radius, float node_mass);
 
 	// Collision
+	void find_contacts() override;
 	void ellipse_collider() override;
-	void is_colliding(GameObject* other, int node_index);
 
 	// GUI
 	void update_gui();
@@ -34,10 +30,10 @@ private:
 	// Draw
 	void draw() override;
 	
-	void get_node_color(int node_index);
-	void draw_connecting_lines();
-	float angle_between(ofVec2f from, ofVec2f to) const;
-	ofVec2f get_point_on_circle(ofVec2f center, float radians, float  radius) const;
+	ofColor get_node_color(int node_index) const;
+	void draw_connecting_lines() const;
+	float angle_between(Vec2 from, Vec2 to) const;
+	Vec2 get_point_on_circle(Vec2 center, float radians, float  radius) const;
 	
 	// Events
 	void mouse_pressed(float x, float y, int button) override;
@@ -49,22 +45,18 @@ private:
 	float get_attribute_by_name(const string name) const override
 	{
 		if (name == "k")
-			return k_;
+			return chain_.k;
 		else if (name == "damping")
-			return damping_;
+			return chain_.damping;
 		else if (name == "springmass")
-			return springmass_;
+			return chain_.springmass;
 	}
 
 
 	
-	float k_;
-	float damping_;
-	float springmass_;
-	float time_step_;	
+	SpringChain chain_;
 
 	bool fill_ellipses_;
-	
-	vector<ofVec2f> fluid_velocities_;
+	bool add_node_triggered_; // the gui's add node toggle adds one node each time it's switched on
 
 };
\ No newline at end of file
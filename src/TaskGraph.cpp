@@ -0,0 +1,173 @@
+#include "TaskGraph.h"
+
+TaskGraph::TaskGraph(string name)
+	:	name_(move(name))
+	,	remaining_(0)
+	,	frame_start_(0)
+	,	frame_time_(0)
+	,	critical_path_time_(0)
+{
+}
+
+void TaskGraph::add_task(const string& name, function<void()> work, const initializer_list<string> reads, const initializer_list<string> writes)
+{
+	const int index = static_cast<int>(tasks_.size());
+	tasks_.push_back(make_unique<Task>());
+	Task& task = *tasks_.back();
+	task.name = name;
+	task.allocation_tag = AllocationTracker::register_tag(name);
+	task.work = move(work);
+
+	const auto depend_on = [this, &task, index](const int other)
+	{
+		if (other == index || find(task.predecessors.begin(), task.predecessors.end(), other) != task.predecessors.end()) return;
+		task.predecessors.push_back(other);
+		tasks_[other]->successors.push_back(index);
+	};
+
+	for (const auto& resource : reads)
+	{
+		auto writer = last_writer_.find(resource);
+		if (writer != last_writer_.end()) depend_on(writer->second);
+		readers_[resource].push_back(index);
+	}
+
+	for (const auto& resource : writes)
+	{
+		auto writer = last_writer_.find(resource);
+		if (writer != last_writer_.end()) depend_on(writer->second);
+		for (const int reader : readers_[resource]) depend_on(reader);
+
+		last_writer_[resource] = index;
+		readers_[resource].clear();
+	}
+}
+
+void TaskGraph::run(JobSystem& jobs)
+{
+	if (tasks_.empty()) return;
+
+	frame_start_ = ofGetElapsedTimeMicros();
+	world_ = WorldContext::get_current();
+	remaining_ = static_cast<int>(tasks_.size());
+	for (auto& task : tasks_)
+	{
+		task->waiting_on = static_cast<int>(task->predecessors.size());
+	}
+
+	for (int i = 0; i < static_cast<int>(tasks_.size()); i++)
+	{
+		if (tasks_[i]->predecessors.empty()) jobs.submit([this, &jobs, i] { execute(jobs, i); });
+	}
+
+	// help instead of blocking - with no free workers this thread ends up running the whole graph itself
+	while (remaining_ > 0)
+	{
+		if (!jobs.run_one()) this_thread::yield();
+	}
+
+	frame_time_ = (ofGetElapsedTimeMicros() - frame_start_) / 1000.0f;
+	find_critical_path();
+}
+
+void TaskGraph::execute(JobSystem& jobs, const int index)
+{
+	Task& task = *tasks_[index];
+
+	task.start = ofGetElapsedTimeMicros() - frame_start_;
+	{
+		PROFILE_SCOPE(task.name.c_str());
+		AllocationScope allocation_scope(task.allocation_tag);
+		WorldScope world_scope(world_);
+		task.work();
+	}
+	task.end = ofGetElapsedTimeMicros() - frame_start_;
+
+	for (const int successor : task.successors)
+	{
+		if (--tasks_[successor]->waiting_on == 0) jobs.submit([this, &jobs, successor] { execute(jobs, successor); });
+	}
+
+	remaining_--;
+}
+
+void TaskGraph::find_critical_path()
+{
+	// longest chain of task durations through the graph - tasks are added in dependency order, so one forward pass does it
+	const int count = static_cast<int>(tasks_.size());
+	vector<uint64_t> path_time(count, 0);
+	vector<int> previous(count, -1);
+
+	int last = -1;
+	for (int i = 0; i < count; i++)
+	{
+		const Task& task = *tasks_[i];
+		for (const int predecessor : task.predecessors)
+		{
+			if (path_time[predecessor] > path_time[i])
+			{
+				path_time[i] = path_time[predecessor];
+				previous[i] = predecessor;
+			}
+		}
+		path_time[i] += task.end - task.start;
+
+		if (last < 0 || path_time[i] > path_time[last]) last = i;
+	}
+
+	critical_path_.clear();
+	for (int i = last; i >= 0; i = previous[i])
+	{
+		critical_path_.insert(critical_path_.begin(), i);
+	}
+	critical_path_time_ = (last >= 0) ? path_time[last] / 1000.0f : 0;
+}
+
+string TaskGraph::get_critical_path_string() const
+{
+	string path;
+	for (const int i : critical_path_)
+	{
+		if (!path.empty()) path += " > ";
+		path += tasks_[i]->name;
+	}
+	return path;
+}
+
+void TaskGraph::draw_debug(const float x, const float y) const
+{
+	const float row_height = 14;
+	const float name_width = 140;
+	const float pixels_per_ms = 60;
+
+	ofPushStyle();
+	ofFill();
+
+	ofSetColor(255);
+	ofDrawBitmapString(name_ + "  " + ofToString(frame_time_, 2) + "ms (critical path " + ofToString(critical_path_time_, 2) + "ms)", x, y);
+
+	for (int i = 0; i < static_cast<int>(tasks_.size()); i++)
+	{
+		const Task& task = *tasks_[i];
+		const float row_y = y + (i + 1) * row_height;
+		const bool critical = find(critical_path_.begin(), critical_path_.end(), i) != critical_path_.end();
+
+		ofSetColor(critical ? ofColor(255, 160, 40) : ofColor(160));
+		ofDrawBitmapString(task.name, x, row_y);
+
+		const float bar_x = x + name_width + task.start / 1000.0f * pixels_per_ms;
+		const float bar_width = max(1.0f, (task.end - task.start) / 1000.0f * pixels_per_ms);
+		ofDrawRectangle(bar_x, row_y - row_height + 4, bar_width, row_height - 4);
+	}
+
+	ofPopStyle();
+}
+
+float TaskGraph::get_task_time(const string& name) const
+{
+	for (auto& task : tasks_)
+	{
+		if (task->name == name) return (task->end - task->start) / 1000.0f;
+	}
+	return 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+
+#include "ofMain.h"
+#include "AllocationTracker.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+// a fixed set of per-frame tasks with declared read/write sets, run on the job system
+// dependencies are derived from the declarations in the order tasks are added - a task waits for the last writer of everything it touches, and a writer also waits for every reader since then
+// tasks that don't share anything run concurrently
+class TaskGraph {
+
+public:
+
+	explicit TaskGraph(string name);
+
+	void add_task(const string& name, function<void()> work, initializer_list<string> reads, initializer_list<string> writes);
+
+	// runs every task once and returns when they've all finished, the calling thread helps out
+	void run(JobSystem& jobs);
+
+	// debug view of the last run - a bar per task, the critical path highlighted
+	void draw_debug(float x, float y) const;
+
+	float get_frame_time() const			{ return frame_time_; }
+	float get_critical_path_time() const	{ return critical_path_time_; }
+	string get_critical_path_string() const;
+
+	// ms the named task took in the last run, 0 if there's no such task
+	float get_task_time(const string& name) const;
+
+private:
+
+	struct Task {
+		string name;
+		int allocation_tag = 0;
+		function<void()> work;
+		vector<int> successors;
+		vector<int> predecessors;
+		atomic<int> waiting_on{ 0 };
+
+		// last run, microseconds from the start of the frame
+		uint64_t start = 0;
+		uint64_t end = 0;
+	};
+
+	void execute(JobSystem& jobs, int index);
+	void find_critical_path();
+
+	string name_;
+	vector<unique_ptr<Task>> tasks_;
+
+	// resource -> last writer / readers since that write
+	map<string, int> last_writer_;
+	map<string, vector<int>> readers_;
+
+	atomic<int> remaining_;
+	WorldContext* world_{};		// the world of the thread running the graph, its tasks work on it too
+	uint64_t frame_start_;
+
+	float frame_time_;				// ms
+	float critical_path_time_;		// ms
+	vector<int> critical_path_;
+
+};
@@ -0,0 +1,156 @@
+#include "Body.h"
+
+#include "MathUtils.h"
+
+void Body::add_node(const Vec2 node_pos, const float node_radius, const float node_mass)
+{
+	node_positions.push_back(node_pos);
+	node_velocities.push_back(Vec2());
+	node_accelerations.push_back(Vec2());
+	node_radiuses.push_back(node_radius);
+	node_masses.push_back(node_mass);
+}
+
+void Body::screen_wrap()
+{
+	if (pos.x > 0 + (world::HALF_WORLD_WIDTH))
+	{
+		pos.x = 0 - (world::HALF_WORLD_WIDTH);
+	}
+	if (pos.x < 0 - (world::HALF_WORLD_WIDTH))
+	{
+		pos.x = 0 + (world::HALF_WORLD_WIDTH);
+	}
+	if (pos.y < 0 - (world::HALF_WORLD_HEIGHT))
+	{
+		pos.y = 0 + (world::HALF_WORLD_HEIGHT);
+	}
+	if (pos.y > 0 + (world::HALF_WORLD_HEIGHT))
+	{
+		pos.y = 0 - (world::HALF_WORLD_HEIGHT);
+	}
+}
+
+// a body with nodes only bounces its nodes, the anchor is left where it is
+static void bounce(Vec2& pos, Vec2& vel, const float radius)
+{
+	if (pos.x > 0 + (world::HALF_WORLD_WIDTH) - (radius) / 2)
+	{
+		vel.x *= -1;
+		pos.x = 0 + (world::HALF_WORLD_WIDTH) - (radius) / 2;
+	}
+	if (pos.x < 0 - (world::HALF_WORLD_WIDTH) + (radius) / 2)
+	{
+		vel.x *= -1;
+		pos.x = 0 - (world::HALF_WORLD_WIDTH) + (radius) / 2;
+	}
+	if (pos.y < 0 - (world::HALF_WORLD_HEIGHT) + (radius) / 2)
+	{
+		vel.y *= -1;
+		pos.y = 0 - (world::HALF_WORLD_HEIGHT) + (radius) / 2;
+	}
+	if (pos.y > 0 + (world::HALF_WORLD_HEIGHT) - (radius) / 2)
+	{
+		vel.y *= -1;
+		pos.y = 0 + (world::HALF_WORLD_HEIGHT) - (radius) / 2;
+	}
+}
+
+void Body::screen_bounce()
+{
+	if (!has_nodes())
+	{
+		bounce(pos, vel, radius);
+		return;
+	}
+
+	for (size_t i = 0; i < node_positions.size(); i++)
+	{
+		bounce(node_positions[i], node_velocities[i], node_radiuses[i]);
+	}
+}
+
+void Body::gravity(const bool world_gravity)
+{
+	if (!world_gravity && !affected_by_gravity) return;
+
+	if (!has_nodes())
+	{
+		apply_force(accel, Vec2(0, static_cast<float>(world::GRAVITY_FORCE) * gravity_mult * mass), false);
+		return;
+	}
+
+	for (size_t i = 0; i < node_positions.size(); i++)
+	{
+		apply_force(node_accelerations[i], Vec2(0, static_cast<float>(world::GRAVITY_FORCE) * gravity_mult * node_masses[i]), false);
+	}
+}
+
+void Body::friction()
+{
+	if (!has_nodes())
+	{
+		apply_force(accel, vel * -1 * world::FRICTION_FORCE, true);
+		return;
+	}
+
+	// the nodes' friction ends up on the anchor
+	for (size_t i = 0; i < node_positions.size(); i++)
+	{
+		apply_force(accel, node_velocities[i] * -1 * world::FRICTION_FORCE, false);
+	}
+}
+
+void Body::apply_force(Vec2& to_accel, const Vec2 force, const bool limit, const float limit_amount)
+{
+	if (limit)
+	{
+		to_accel += force.limited(limit_amount);
+	}
+	else
+	{
+		to_accel += force;
+		add_forces();
+	}
+}
+
+void Body::add_forces()
+{
+	// nodes are integrated by their SpringChain
+	if (has_nodes()) return;
+
+	vel = (vel + accel).limited(world::MAXIMUM_VELOCITY);
+	pos += vel;
+}
+
+void Body::add_forces_interpolated(const uint64_t frame)
+{
+	if (has_nodes()) return;
+
+	vel = (vel + accel).limited(world::MAXIMUM_VELOCITY);
+	pos = get_interpolated_position(frame);
+}
+
+Vec2 Body::get_interpolated_position(const uint64_t frame) const
+{
+	// the progress is an integer division, so always 0 - and ofNextPow2(0) is 1, a full step
+	const int progress = static_cast<int>(frame % 100) / 100;
+	int pow_interp = 1;
+	while (pow_interp < progress) pow_interp <<= 1;
+
+	return Vec2(lerp(pos.x, pos.x + vel.x, static_cast<float>(pow_interp)), lerp(pos.y, pos.y + vel.y, static_cast<float>(pow_interp)));
+}
+
+void Body::collide(const Vec2 other_pos, const bool hard)
+{
+	const Vec2 force_vec = pos - other_pos;
+	if (hard)
+	{
+		if (prev_pos != Vec2(BODY_NO_PREVIOUS_POSITION, BODY_NO_PREVIOUS_POSITION)) pos = prev_pos;
+		apply_force(accel, force_vec / mass, false);
+	}
+	else
+	{
+		apply_force(accel, force_vec / mass, true);
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Vec2.h"
+#include "World.h"
+
+#define BODY_NO_PREVIOUS_POSITION 99999 // prev_pos until the first step has run
+
+// an entity's physical state and the shared behaviours (modules) that move it, with nothing from oF
+// either a single body, or an anchor at pos with a chain of nodes hanging off it (springs, see SpringChain)
+// GameObject owns one and decides which modules run, and in what order
+struct Body {
+
+	Vec2 pos;
+	Vec2 prev_pos{ BODY_NO_PREVIOUS_POSITION, BODY_NO_PREVIOUS_POSITION };
+	Vec2 vel;
+	Vec2 accel;
+	float mass = 10;
+	float radius = 35;
+
+	bool infinite_mass = false;
+	bool affected_by_gravity = false;
+	int gravity_mult = 1;
+	int collision_mult = 1;
+
+	std::vector<Vec2> node_positions;
+	std::vector<Vec2> node_velocities;
+	std::vector<Vec2> node_accelerations;
+	std::vector<float> node_radiuses;
+	std::vector<float> node_masses;
+
+	bool has_nodes() const										{ return !node_positions.empty(); }
+	void add_node(Vec2 node_pos, float node_radius, float node_mass);
+
+	// modules
+	void screen_wrap();		// leaving one edge of the world comes back in at the opposite one
+	void screen_bounce();	// the world's edges reflect
+	void gravity(bool world_gravity);
+	void friction();
+
+	// a limited force is clamped and waits for the next add_forces, an unlimited one is integrated straight away
+	void apply_force(Vec2& to_accel, Vec2 force, bool limit = true, float limit_amount = world::MAXIMUM_ACCELERATION);
+	void add_forces();
+	void add_forces_interpolated(uint64_t frame);
+
+	// pushed away from what it hit - a hard collision also steps back to where it was before this step
+	void collide(Vec2 other_pos, bool hard);
+
+private:
+
+	Vec2 get_interpolated_position(uint64_t frame) const;
+
+};
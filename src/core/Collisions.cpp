@@ -1,6 +1,6 @@
 #include "Collisions.h"
 
-bool Collisions::ellipse_compare(const ofVec2f pos1, const float r1, const ofVec2f pos2, const float r2)
+bool Collisions::ellipse_compare(const Vec2 pos1, const float r1, const Vec2 pos2, const float r2)
 {
 	const float dist = pos2.distance(pos1);
 
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Vec2.h"
+
+class Collisions
+{
+
+public:
+	static bool ellipse_compare(Vec2 pos1, float r1, Vec2 pos2, float r2);
+
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Vec2.h"
+#include "World.h"
+
+// what the simulation reads from the fluid - the app backs it with its solver
+// only the velocity is read during a step, adding forces and colour back into the fluid is left to the app
+class FluidField {
+
+public:
+
+	virtual ~FluidField() = default;
+
+	// at a position normalised to 0-1 across the fluid
+	virtual Vec2 velocity_at(Vec2 normalised_pos) const = 0;
+
+	// at a position in the world, which is centred on 0, 0
+	Vec2 velocity_at_world(const Vec2 world_pos) const
+	{
+		return velocity_at(Vec2(world_pos.x + world::HALF_WORLD_WIDTH, world_pos.y + world::HALF_WORLD_HEIGHT) * Vec2(1.0f / world::WORLD_WIDTH, 1.0f / world::WORLD_HEIGHT));
+	}
+
+};
@@ -0,0 +1,48 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+
+using namespace std;
+
+atomic<uint64_t> FrameArena::frame_(1);
+thread_local FrameArena::Arena FrameArena::arena_;
+
+void FrameArena::rewind()
+{
+	Arena& arena = arena_;
+	arena.frame = frame_.load(memory_order_relaxed);
+	arena.block = 0;
+	arena.offset = 0;
+}
+
+void* FrameArena::allocate_bytes(const size_t bytes, const size_t alignment)
+{
+	Arena& arena = arena_;
+
+	const uint64_t frame = frame_.load(memory_order_relaxed);
+	if (arena.frame != frame)
+	{
+		arena.frame = frame;
+		arena.block = 0;
+		arena.offset = 0;
+	}
+
+	// first block from the current one on that fits, the blocks after a full one are reused before anything new is allocated
+	for (; arena.block < arena.blocks.size(); arena.block++, arena.offset = 0)
+	{
+		auto& block = arena.blocks[arena.block];
+		const size_t start = (arena.offset + alignment - 1) & ~(alignment - 1);
+		if (start + bytes <= block.second)
+		{
+			arena.offset = start + bytes;
+			return block.first.get() + start;
+		}
+	}
+
+	// new[] of char is aligned for any fundamental type
+	const size_t size = max<size_t>(bytes, FRAME_ARENA_BLOCK_SIZE);
+	arena.blocks.emplace_back(unique_ptr<char[]>(new char[size]), size);
+	arena.block = arena.blocks.size() - 1;
+	arena.offset = bytes;
+	return arena.blocks.back().first.get();
+}
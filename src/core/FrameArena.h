@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define FRAME_ARENA_BLOCK_SIZE	65536	// bytes, a request bigger than this gets a block of its own size
+
+// per thread linear allocator for data that only lives for the rest of the frame - allocating is a pointer bump, nothing is freed individually
+// each thread's arena rewinds the first time it allocates in a new frame, its blocks are kept, so once they've grown to fit a frame it never touches the heap
+// anything taken from it is invalid after the next next_frame(), and only trivially destructible types are allowed since nothing is destroyed
+class FrameArena {
+
+public:
+
+	// main thread, at the start of the frame while nothing else is running
+	static void next_frame()		{ frame_.fetch_add(1, std::memory_order_relaxed); }
+
+	// the calling thread's arena only, for threads that step frames of their own (batch worlds) - what it handed out is invalid after this
+	static void rewind();
+
+	// uninitialised storage for count Ts
+	template<class T>
+	static T* allocate(const size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "frame arena memory is never destroyed");
+		return static_cast<T*>(allocate_bytes(sizeof(T) * count, alignof(T)));
+	}
+
+	static void* allocate_bytes(size_t bytes, size_t alignment);
+
+private:
+
+	struct Arena {
+		std::vector<std::pair<std::unique_ptr<char[]>, size_t>> blocks;	// memory, size
+		size_t block = 0;
+		size_t offset = 0;
+		uint64_t frame = 0;
+	};
+
+	static std::atomic<uint64_t> frame_;
+	static thread_local Arena arena_;
+
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+// the scalar helpers the simulation used from oF, with the same results
+
+inline float lerp(const float from, const float to, const float amount)
+{
+	return from + (to - from) * amount;
+}
+
+// value from one range to another, not clamped (ofMap)
+inline float remap(const float value, const float in_min, const float in_max, const float out_min, const float out_max)
+{
+	return (value - in_min) / (in_max - in_min) * (out_max - out_min) + out_min;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// a handle refers to an object inside an ObjectPool - every time a slot is released its generation is bumped, so an old handle resolves to nullptr instead of whatever object reuses the slot
+struct PoolHandle {
+
+	uint32_t index = UINT32_MAX;
+	uint32_t generation = 0;
+	uint8_t pool = 0;
+
+	bool is_valid() const { return index != UINT32_MAX; }
+
+	bool operator==(const PoolHandle& other) const { return index == other.index && generation == other.generation && pool == other.pool; }
+	bool operator!=(const PoolHandle& other) const { return !(*this == other); }
+};
+
+// fixed-block storage for one object type - slots are allocated in blocks that are never freed until the pool is destroyed, so creating and releasing objects does not touch the allocator once the pool has warmed up
+// live slots are also tracked in a dense array which is kept packed with swap-and-pop, so iterating/clearing the pool is O(live objects)
+template <typename T, size_t BlockSize = 64>
+class ObjectPool {
+
+public:
+
+	explicit ObjectPool(const uint8_t pool_id = 0)
+		:	pool_id_(pool_id)
+	{
+	}
+
+	~ObjectPool()
+	{
+		clear();
+	}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	template <typename... Args>
+	PoolHandle create(Args&&... args)
+	{
+		uint32_t index;
+		if (!free_slots_.empty())
+		{
+			index = free_slots_.back();
+			free_slots_.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(blocks_.size() * BlockSize);
+			blocks_.emplace_back(new Slot[BlockSize]);
+			// hand out the new block front to back
+			for (uint32_t i = BlockSize - 1; i > 0; i--)
+			{
+				free_slots_.push_back(index + i);
+			}
+		}
+
+		Slot& slot = get_slot(index);
+		new (&slot.storage) T(std::forward<Args>(args)...);
+		slot.alive = true;
+		slot.dense_index = static_cast<uint32_t>(dense_.size());
+		dense_.push_back(index);
+
+		PoolHandle handle;
+		handle.index = index;
+		handle.generation = slot.generation;
+		handle.pool = pool_id_;
+		return handle;
+	}
+
+	T* get(const PoolHandle handle) const
+	{
+		if (!handle.is_valid() || handle.pool != pool_id_ || handle.index >= blocks_.size() * BlockSize)
+		{
+			return nullptr;
+		}
+
+		Slot& slot = get_slot(handle.index);
+		if (!slot.alive || slot.generation != handle.generation)
+		{
+			return nullptr;
+		}
+		return get_object(slot);
+	}
+
+	bool release(const PoolHandle handle)
+	{
+		if (get(handle) == nullptr)
+		{
+			return false;
+		}
+		release_slot(handle.index);
+		return true;
+	}
+
+	// destroys every live object - O(n) and keeps all blocks for reuse
+	void clear()
+	{
+		for (const uint32_t index : dense_)
+		{
+			Slot& slot = get_slot(index);
+			get_object(slot)->~T();
+			slot.alive = false;
+			slot.generation++;
+			free_slots_.push_back(index);
+		}
+		dense_.clear();
+	}
+
+	size_t size() const			{ return dense_.size(); }
+	size_t capacity() const		{ return blocks_.size() * BlockSize; }
+	uint8_t get_pool_id() const	{ return pool_id_; }
+
+private:
+
+	struct Slot {
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		uint32_t generation = 0;
+		uint32_t dense_index = 0;
+		bool alive = false;
+	};
+
+	Slot& get_slot(const uint32_t index) const
+	{
+		return blocks_[index / BlockSize][index % BlockSize];
+	}
+
+	static T* get_object(Slot& slot)
+	{
+		return reinterpret_cast<T*>(&slot.storage);
+	}
+
+	void release_slot(const uint32_t index)
+	{
+		Slot& slot = get_slot(index);
+		get_object(slot)->~T();
+		slot.alive = false;
+		slot.generation++;
+
+		// swap-and-pop the dense entry so the live list stays packed
+		const uint32_t last = dense_.back();
+		dense_[slot.dense_index] = last;
+		get_slot(last).dense_index = slot.dense_index;
+		dense_.pop_back();
+
+		free_slots_.push_back(index);
+	}
+
+	uint8_t pool_id_;
+
+	std::vector<std::unique_ptr<Slot[]>> blocks_;
+	std::vector<uint32_t> free_slots_;
+	std::vector<uint32_t> dense_;
+};
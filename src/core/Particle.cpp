@@ -0,0 +1,138 @@
+#include "Particle.h"
+
+#include <algorithm>
+
+#include "MathUtils.h"
+
+static const float MOMENTUM = 0.5f;
+static const float FLUID_FORCE = 0.6f;
+
+void Particle::init(const float x, const float y, RandomStream& random)
+{
+	pos_ = Vec2(x, y);
+	vel_ = Vec2(0, 0);
+	alpha = random.range(0.3f, 1);
+	mass_ = random.range(0.1f, 1);
+}
+
+void Particle::update(const FluidField& fluid, const Vec2 window_size, const Vec2 inv_window_size, RandomStream& random)
+{
+	// only update if particle is visible
+	if (alpha == 0)
+		return;
+
+	vel_ = fluid.velocity_at(pos_ * inv_window_size) * (mass_ * FLUID_FORCE) * window_size + vel_ * MOMENTUM;
+	pos_ += vel_;
+
+	// reposition 'out of bounds' particles at random positions
+	if (pos_.x < 0)
+	{
+		pos_.x = random.range(0, window_size.x);
+		pos_.y = random.range(0, window_size.y);
+		vel_ = Vec2();
+	}
+	else if (pos_.x > window_size.x)
+	{
+		pos_.x = random.range(0, window_size.x);
+		pos_.y = random.range(0, window_size.y);
+		vel_ = Vec2();
+	}
+	else if (pos_.y < 0)
+	{
+		pos_.x = random.range(0, window_size.x);
+		pos_.y = random.range(0, window_size.y);
+		vel_ = Vec2();
+	}
+	else if (pos_.y > window_size.y)
+	{
+		pos_.x = random.range(0, window_size.x);
+		pos_.y = random.range(0, window_size.y);
+		vel_ = Vec2();
+	}
+	
+	if (alpha < 0.01f)
+		alpha = 0;
+}
+
+void Particle::update_vertex_arrays(const bool drawing_fluid, const Vec2 inv_window_size, const int i, float* pos_buffer, float* col_buffer) const
+{
+
+	{
+		if (alpha == 0)
+			return;
+		
+		int vi = i * 4;
+		pos_buffer[vi++] = pos_.x - std::max(vel_.x, vel_.x + 0.25f);		// <--- particles will not get smaller than a certain size (0.25f)
+		pos_buffer[vi++] = pos_.y - std::max(vel_.y, vel_.y + 0.25f);
+		pos_buffer[vi++] = pos_.x;
+		pos_buffer[vi++] = pos_.y;
+
+		float r, g, b;
+		get_line_color(drawing_fluid, inv_window_size, r, g, b);
+
+		int ci = i * 6;
+		col_buffer[ci++] = r;
+		col_buffer[ci++] = g;
+		col_buffer[ci++] = b;
+		col_buffer[ci++] = r;
+		col_buffer[ci++] = g;
+		col_buffer[ci++] = b;
+	}
+}
+
+void Particle::get_line_color(const bool drawing_fluid, const Vec2 inv_window_size, float& r, float& g, float& b) const
+{
+	if (drawing_fluid)
+	{
+		// if drawing fluid, draw lines as black & white
+		r = g = b = alpha;
+	}
+	else
+	{
+		// otherwise, use color
+		const float vx_norm = vel_.x * inv_window_size.x;
+		const float vy_norm = vel_.y * inv_window_size.y;
+		float v2 = vx_norm * vx_norm + vy_norm * vy_norm;
+		#define VMAX 0.013f
+		if (v2 > VMAX * VMAX) v2 = VMAX * VMAX;
+		float sat_inc = mass_ > 0.5 ? mass_ * mass_ * mass_ : 0;
+		sat_inc *= sat_inc * sat_inc * sat_inc;
+		const float sat = std::min(std::max(v2 * 255.0f / (VMAX * VMAX) + sat_inc, 0.0f), 255.0f);
+		const float bri = std::min(std::max(lerp(0.5f, 1, mass_) * alpha * 255.0f, 0.0f), 255.0f);
+
+		// ofColor::setHsb at hue 0, down to its 8 bit channels - red is the brightness, green and blue are what the saturation leaves of it
+		unsigned char red = 0, other = 0;
+		if (bri > 0)
+		{
+			red = static_cast<unsigned char>(bri);
+			other = (sat > 0) ? static_cast<unsigned char>((1.0f - sat / 255.0f) * bri) : red;
+		}
+
+		// GL clamps float vertex colours to [0,1], so any lit channel draws at full - the splat has to see the same values
+		r = std::min(static_cast<float>(red), 1.0f);
+		g = std::min(static_cast<float>(other), 1.0f);
+		b = std::min(static_cast<float>(other), 1.0f);
+	}
+}
+
+void Particle::splat(const bool drawing_fluid, const Vec2 inv_window_size, float* density, const int grid_width, const int grid_height, const float texel_size, const float weight) const
+{
+	if (alpha == 0)
+		return;
+
+	const int x = static_cast<int>(pos_.x / texel_size);
+	const int y = static_cast<int>(pos_.y / texel_size);
+	if (x < 0 || y < 0 || x >= grid_width || y >= grid_height)
+		return;
+
+	// a line adds light in proportion to its length, same minimum length as the vertex path
+	const float length = Vec2(std::max(vel_.x, vel_.x + 0.25f), std::max(vel_.y, vel_.y + 0.25f)).length();
+
+	float r, g, b;
+	get_line_color(drawing_fluid, inv_window_size, r, g, b);
+
+	float* texel = density + (y * grid_width + x) * 3;
+	texel[0] += r * length * weight;
+	texel[1] += g * length * weight;
+	texel[2] += b * length * weight;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "FluidField.h"
+#include "Random.h"
+#include "Vec2.h"
+
+class Particle
+{
+public:
+	
+	void init(float x, float y, RandomStream& random);
+	void update(const FluidField& fluid, Vec2 window_size, Vec2 inv_window_size, RandomStream& random);
+	void update_vertex_arrays(bool drawing_fluid, Vec2 inv_window_size, int i, float* pos_buffer, float* col_buffer) const;
+	bool is_within(const float left, const float top, const float right, const float bottom) const { return pos_.x > left && pos_.x < right && pos_.y > top && pos_.y < bottom; }
+	void splat(bool drawing_fluid, Vec2 inv_window_size, float* density, int grid_width, int grid_height, float texel_size, float weight) const;
+	
+	float alpha{};
+
+private:
+
+	void get_line_color(bool drawing_fluid, Vec2 inv_window_size, float& r, float& g, float& b) const;
+	
+	Vec2 pos_;
+	Vec2 vel_;
+	float mass_{};
+	
+};
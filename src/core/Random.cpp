@@ -0,0 +1,79 @@
+#include "Random.h"
+#include "WorldContext.h"
+
+static uint64_t splitmix64(uint64_t& x)
+{
+	uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+RandomStream::RandomStream(const uint64_t seed)
+{
+	this->seed(seed);
+}
+
+void RandomStream::seed(uint64_t seed)
+{
+	const uint64_t a = splitmix64(seed);
+	const uint64_t b = splitmix64(seed);
+	state_[0] = static_cast<uint32_t>(a);
+	state_[1] = static_cast<uint32_t>(a >> 32);
+	state_[2] = static_cast<uint32_t>(b);
+	state_[3] = static_cast<uint32_t>(b >> 32);
+
+	// all zero is the one state xoshiro never leaves
+	if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) state_[0] = 1;
+}
+
+void RandomStream::fill(float* values, const int count, const float min, const float max)
+{
+	// lane l's state is s0[l]..s3[l], every step does the same thing to all four lanes
+	uint32_t s0[4], s1[4], s2[4], s3[4];
+	for (int lane = 0; lane < 4; lane++)
+	{
+		s0[lane] = next_uint();
+		s1[lane] = next_uint();
+		s2[lane] = next_uint();
+		s3[lane] = next_uint() | 1;
+	}
+
+	const float scale = (max - min) * (1.0f / 16777216.0f);
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		for (int lane = 0; lane < 4; lane++)
+		{
+			const uint32_t result = s0[lane] + s3[lane];
+			const uint32_t t = s1[lane] << 9;
+			s2[lane] ^= s0[lane];
+			s3[lane] ^= s1[lane];
+			s1[lane] ^= s2[lane];
+			s0[lane] ^= s3[lane];
+			s2[lane] ^= t;
+			s3[lane] = (s3[lane] << 11) | (s3[lane] >> 21);
+			values[i + lane] = min + (result >> 8) * scale;
+		}
+	}
+
+	for (; i < count; i++)
+	{
+		values[i] = range(min, max);
+	}
+}
+
+void Random::seed(const uint64_t seed)
+{
+	WorldContext::current().seed(seed);
+}
+
+uint64_t Random::get_seed()
+{
+	return WorldContext::current().get_seed();
+}
+
+RandomStream& Random::get(const RandomStreamId id)
+{
+	return WorldContext::current().random(id);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+#define RANDOM_DEFAULT_SEED		1
+
+// simulation subsystems that draw random numbers - each has its own stream, so one drawing more or less doesn't shift the others
+enum RandomStreamId {
+	RANDOM_PARTICLES,
+	RANDOM_FLUID,
+	RANDOM_ENTITIES,
+	RANDOM_PLAYER,
+	RANDOM_SCENE,
+	RANDOM_STREAM_COUNT
+};
+
+// xoshiro128+ - four words of state, a handful of adds, xors and shifts per number, floats from the top 24 bits
+// a stream is owned by one thread at a time, nothing here is shared or locked
+class RandomStream {
+
+public:
+
+	explicit RandomStream(uint64_t seed = RANDOM_DEFAULT_SEED);
+
+	// splitmix64 spreads the seed over the state, so nearby seeds still give unrelated streams
+	void seed(uint64_t seed);
+
+	uint32_t next_uint()
+	{
+		const uint32_t result = state_[0] + state_[3];
+		const uint32_t t = state_[1] << 9;
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+		state_[2] ^= t;
+		state_[3] = (state_[3] << 11) | (state_[3] >> 21);
+		return result;
+	}
+
+	// [0, 1)
+	float next_float()								{ return (next_uint() >> 8) * (1.0f / 16777216.0f); }
+
+	// [min, max)
+	float range(float min, float max)				{ return min + next_float() * (max - min); }
+
+	// count numbers in [min, max) - four interleaved generators seeded from this one, laid out so the compiler can vectorise the loop
+	void fill(float* values, int count, float min, float max);
+
+private:
+
+	uint32_t state_[4];
+
+};
+
+// the current world's streams (see WorldContext), all reseeded together so a scene plus a seed plays out the same every time
+// the simulation thread and the main thread never step the same world at the same time (the simulation mutex), so the streams need no locking
+class Random {
+
+public:
+
+	static void seed(uint64_t seed);
+	static uint64_t get_seed();
+
+	static RandomStream& get(RandomStreamId id);
+
+};
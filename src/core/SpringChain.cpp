@@ -0,0 +1,74 @@
+#include "SpringChain.h"
+
+#include "MathUtils.h"
+
+void SpringChain::add_node(Body& body, const Vec2 node_pos, const float node_radius, const float node_mass)
+{
+	body.add_node(node_pos, node_radius, node_mass);
+	fluid_velocities.push_back(Vec2());
+}
+
+Vec2 SpringChain::spring_force(const Body& body, const int node) const
+{
+	// a node is pulled by the spring to the node above it (the anchor for the first) and pushed back by the spring to the one below it
+	const auto spring = [this, &body](const int i)
+	{
+		const Vec2& above = (i == 0) ? body.pos : body.node_positions[i - 1];
+		return Vec2(-k * (body.node_positions[i].x - above.x), -k * (body.node_positions[i].y - above.y));
+	};
+	const auto damp = [this, &body](const int i)
+	{
+		return Vec2(damping * body.node_velocities[i].x, damping * body.node_velocities[i].y);
+	};
+
+	Vec2 force = spring(node) - damp(node);
+	if (node + 1 < static_cast<int>(body.node_positions.size()))
+	{
+		force -= spring(node + 1) - damp(node + 1);
+	}
+	force.y += springmass;
+
+	return force / springmass;
+}
+
+Vec2 SpringChain::fluid_force(const Body& body, const int node, const FluidField& fluid)
+{
+	const Vec2 window_size(world::WORLD_WIDTH, world::WORLD_HEIGHT);
+
+	return fluid_velocities[node] = fluid.velocity_at_world(body.node_positions[node]) * remap(body.node_masses[node], 0, 500, 0.06f, 0.006f) * window_size + fluid_velocities[node] * 0.5f;
+}
+
+void SpringChain::apply_forces(Body& body, const FluidField& fluid)
+{
+	for (size_t i = 0; i < body.node_positions.size(); i++)
+	{
+		const int node = static_cast<int>(i);
+		body.apply_force(body.node_accelerations[i], spring_force(body, node) * time_step, false);
+		body.apply_force(body.node_accelerations[i], fluid_force(body, node, fluid), true, 10.0f);
+	}
+}
+
+void SpringChain::integrate(Body& body) const
+{
+	for (size_t i = 0; i < body.node_positions.size(); i++)
+	{
+		body.node_velocities[i] += body.node_accelerations[i];
+		body.node_positions[i] += body.node_velocities[i] * time_step;
+	}
+}
+
+void SpringChain::reset_forces(Body& body) const
+{
+	for (auto& node_accel : body.node_accelerations)
+	{
+		node_accel = Vec2();
+	}
+}
+
+void SpringChain::collide_node(Body& body, const int node, const Vec2 other_pos) const
+{
+	const Vec2 force_vec = body.node_positions[node] - other_pos;
+	Vec2 accel = force_vec / body.node_masses[node];
+	accel *= static_cast<float>(body.collision_mult);
+	body.apply_force(body.node_accelerations[node], accel, false);
+}
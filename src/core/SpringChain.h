@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include "Body.h"
+#include "FluidField.h"
+
+// the spring forces on a chain of nodes hanging from a Body's anchor, each node held by a spring to the one above it
+// the nodes themselves (positions, velocities, masses) live in the Body, so the shared modules see them as well
+struct SpringChain {
+
+	float k = 0;
+	float damping = 0;
+	float springmass = 0;
+	float time_step = 0.28f;
+
+	std::vector<Vec2> fluid_velocities; // one per node, the fluid force carries over half of the last one
+
+	SpringChain() = default;
+	SpringChain(const float k, const float damping, const float springmass) : k(k), damping(damping), springmass(springmass) {}
+
+	void add_node(Body& body, Vec2 node_pos, float node_radius, float node_mass);
+
+	Vec2 spring_force(const Body& body, int node) const;
+	Vec2 fluid_force(const Body& body, int node, const FluidField& fluid);
+
+	// one step - the forces, then the nodes move, then their accelerations start again from zero
+	void apply_forces(Body& body, const FluidField& fluid);
+	void integrate(Body& body) const;
+	void reset_forces(Body& body) const;
+
+	// a node pushed away from something it hit, scaled by the body's collision_mult
+	void collide_node(Body& body, int node, Vec2 other_pos) const;
+
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Vec2.h"
+
+// everything a simulation step reads from outside the simulation - filled in once per frame by the app, under the simulation lock
+// the step reads this instead of asking oF, so a step's result only depends on the world and its input
+struct StepInput {
+
+	uint64_t frame = 0;
+
+	// window pixels, latched once per frame (or replayed from an input journal)
+	int mouse_x = 0;
+	int mouse_y = 0;
+
+	int window_width = 0;
+	int window_height = 0;
+
+	// the mouse relative to the middle of the window
+	Vec2 get_centered_mouse() const								{ return Vec2(static_cast<float>(mouse_x - window_width / 2), static_cast<float>(mouse_y - window_height / 2)); }
+
+};
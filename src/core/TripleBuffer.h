@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+
+// single producer / single consumer hand-off of whole frames
+// the writer always has a slot of its own to fill, the reader always has a complete one to read - neither ever waits on the other, the reader just picks up the newest published slot
+template<class T>
+class TripleBuffer {
+
+public:
+
+	TripleBuffer()
+		:	write_(0)
+		,	read_(1)
+		,	ready_(2)
+	{
+	}
+
+	// writer side
+	T& get_write_buffer()					{ return slots_[write_]; }
+
+	void publish()
+	{
+		// swap the filled slot into 'ready' and take whatever was there as the next one to write
+		const int previous = ready_.exchange(write_ | fresh_bit, std::memory_order_acq_rel);
+		write_ = previous & index_mask;
+	}
+
+	// reader side - returns true if a newer frame was picked up
+	bool update()
+	{
+		if ((ready_.load(std::memory_order_acquire) & fresh_bit) == 0) return false;
+
+		const int previous = ready_.exchange(read_, std::memory_order_acq_rel);
+		read_ = previous & index_mask;
+		return true;
+	}
+
+	const T& get_read_buffer() const		{ return slots_[read_]; }
+
+private:
+
+	static const int fresh_bit = 4;
+	static const int index_mask = 3;
+
+	T slots_[3];
+
+	int write_;					// owned by the writer
+	int read_;					// owned by the reader
+	std::atomic<int> ready_;	// shared, slot index + fresh flag
+
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+
+// the simulation core's 2d vector - plain floats, nothing from oF
+// converts explicitly from anything with an x and a y (ofVec2f, glm::vec2, MSA::Vec2f), so crossing from the app's vectors into the core is always spelled out
+struct Vec2 {
+
+	float x = 0;
+	float y = 0;
+
+	Vec2() = default;
+	Vec2(const float x, const float y) : x(x), y(y) {}
+
+	template<class T>
+	explicit Vec2(const T& v) : x(v.x), y(v.y) {}
+
+	// back to the app's vector type
+	template<class T>
+	T to() const												{ return T(x, y); }
+
+	Vec2 operator+(const Vec2& v) const							{ return { x + v.x, y + v.y }; }
+	Vec2 operator-(const Vec2& v) const							{ return { x - v.x, y - v.y }; }
+	Vec2 operator-() const										{ return { -x, -y }; }
+	Vec2 operator*(const Vec2& v) const							{ return { x * v.x, y * v.y }; }
+	Vec2 operator*(const float s) const							{ return { x * s, y * s }; }
+	Vec2 operator/(const float s) const							{ return { x / s, y / s }; }
+	Vec2& operator+=(const Vec2& v)								{ x += v.x; y += v.y; return *this; }
+	Vec2& operator-=(const Vec2& v)								{ x -= v.x; y -= v.y; return *this; }
+	Vec2& operator*=(const float s)								{ x *= s; y *= s; return *this; }
+	Vec2& operator/=(const float s)								{ x /= s; y /= s; return *this; }
+
+	bool operator==(const Vec2& v) const						{ return x == v.x && y == v.y; }
+	bool operator!=(const Vec2& v) const						{ return !(*this == v); }
+
+	float dot(const Vec2& v) const								{ return x * v.x + y * v.y; }
+	float length_squared() const								{ return x * x + y * y; }
+	float length() const										{ return std::sqrt(length_squared()); }
+	float distance_squared(const Vec2& v) const					{ return (*this - v).length_squared(); }
+	float distance(const Vec2& v) const							{ return (*this - v).length(); }
+
+	Vec2 normalized() const
+	{
+		const float l = length();
+		return (l > 0) ? *this / l : Vec2();
+	}
+
+	// shortened to max if it's longer, the same as ofVec2f::limit
+	Vec2 limited(const float max) const
+	{
+		const float l2 = length_squared();
+		if (l2 > max * max && l2 > 0) return *this * (max / std::sqrt(l2));
+		return *this;
+	}
+
+};
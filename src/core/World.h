@@ -0,0 +1,31 @@
+#pragma once
+
+// the world's size and the physical limits everything in it is held to
+
+namespace world {
+
+constexpr int MINIMUM_MASS = 1;
+constexpr int MAXIMUM_MASS = 5000;
+
+constexpr int MASS_LOWER_BOUND = 250;
+constexpr int MASS_UPPER_BOUND = 2500;
+
+constexpr int RADIUS_MINIMUM = 15;
+constexpr int RADIUS_MAXIMUM = 500;
+
+constexpr int RADIUS_LOWER_BOUND = 25;
+constexpr int RADIUS_UPPER_BOUND = 250;
+
+constexpr float MAXIMUM_ACCELERATION = 0.15f; // 0.15
+constexpr int MAXIMUM_VELOCITY = 100; // 15
+
+constexpr float FRICTION_FORCE = 0.015f;
+constexpr float GRAVITY_FORCE = 0.0001f;
+
+constexpr int WORLD_WIDTH = 2000 * 2;
+constexpr int WORLD_HEIGHT = 1500 * 2;
+
+constexpr int HALF_WORLD_WIDTH = WORLD_WIDTH / 2;
+constexpr int HALF_WORLD_HEIGHT = WORLD_HEIGHT / 2;
+
+}
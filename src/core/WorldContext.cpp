@@ -0,0 +1,18 @@
+#include "WorldContext.h"
+
+WorldContext WorldContext::default_;
+thread_local WorldContext* WorldContext::current_ = &WorldContext::default_;
+
+WorldContext::WorldContext(const uint64_t seed)
+{
+	this->seed(seed);
+}
+
+void WorldContext::seed(const uint64_t seed)
+{
+	seed_ = seed;
+	for (int i = 0; i < RANDOM_STREAM_COUNT; i++)
+	{
+		streams_[i].seed(seed * RANDOM_STREAM_COUNT + i);
+	}
+}
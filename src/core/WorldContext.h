@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Random.h"
+
+// how far through a level's chain of collectables the player is
+struct CollectableProgress {
+
+	bool first_point = true;
+	int last_id_collected = -404;
+	int cur_id = -1;			// the id the last collectable created got
+	int collectable_count = 0;
+	int points_collected = 0;
+
+	void reset()				{ *this = CollectableProgress(); }
+
+};
+
+// the state a world keeps outside its objects and managers - its random streams and the collectable chain
+// every thread works on one world at a time, the current one, which is the app's own world unless a WorldScope says otherwise
+// so any number of worlds can step side by side on different threads without sharing anything
+class WorldContext {
+
+public:
+
+	explicit WorldContext(uint64_t seed = RANDOM_DEFAULT_SEED);
+
+	// stream i starts from seed * RANDOM_STREAM_COUNT + i
+	void seed(uint64_t seed);
+	uint64_t get_seed() const								{ return seed_; }
+
+	RandomStream& random(const RandomStreamId id)			{ return streams_[id]; }
+
+	CollectableProgress collectables;
+
+	static WorldContext& current()							{ return *current_; }
+	static WorldContext* get_current()						{ return current_; }
+	static void set_current(WorldContext* world)			{ current_ = world; }
+
+	// the world every thread starts on
+	static WorldContext& get_default()						{ return default_; }
+
+private:
+
+	uint64_t seed_;
+	RandomStream streams_[RANDOM_STREAM_COUNT];
+
+	static WorldContext default_;
+	static thread_local WorldContext* current_;
+
+};
+
+// makes a world current for the rest of the enclosing block
+class WorldScope {
+
+public:
+
+	explicit WorldScope(WorldContext* world)
+		:	previous_(WorldContext::get_current())
+	{
+		WorldContext::set_current(world);
+	}
+
+	~WorldScope()
+	{
+		WorldContext::set_current(previous_);
+	}
+
+	WorldScope(const WorldScope&) = delete;
+	WorldScope& operator=(const WorldScope&) = delete;
+
+private:
+
+	WorldContext* previous_;
+
+};
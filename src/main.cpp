@@ -1,11 +1,27 @@
 #include "ofMain.h"
+#include "ofAppNoWindow.h"
 #include "ofApp.h"
+#include "RunOptions.h"
 
-int main()
+int main(int argc, char* argv[])
 {
+	const RunOptions options = RunOptions::parse(argc, argv);
+
+	if (options.headless)
+	{
+		// no window and no GL context - the app only steps the simulation
+		ofWindowSettings settings;
+		settings.setSize(1900, 1000);
+		auto window = make_shared<ofAppNoWindow>();
+		window->setup(settings);
+		ofGetMainLoop()->addWindow(window);
+		ofRunApp(window, make_shared<ofApp>(options));
+		return ofRunMainLoop();
+	}
+
 	ofGLWindowSettings settings;
 	settings.setSize(1900, 1000);
 	settings.setGLVersion(2, 1);
 	ofCreateWindow(settings);
-	ofRunApp(new ofApp());
-}
\ No newline at end of file
+	ofRunApp(new ofApp(options));
+}
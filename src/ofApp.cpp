@@ -2,7 +2,7 @@
 
 void ofApp::setup()
 {
-	iota_app.setup(this);
+	iota_app.setup(this, options_);
 }
 
 void ofApp::audioOut(float* output, int bufferSize, int nChannels)
@@ -20,6 +20,11 @@ void ofApp::draw()
 	iota_app.draw();
 }
 
+void ofApp::exit()
+{
+	iota_app.exit();
+}
+
 void ofApp::keyPressed(int key)
 {
 	iota_app.key_pressed(key);
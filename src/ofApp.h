@@ -3,14 +3,18 @@
 #include "ofMain.h"
 
 #include "Iota.h"
+#include "RunOptions.h"
 
 class ofApp : public ofBaseApp
 {
 public:
+	explicit ofApp(const RunOptions& options = RunOptions()) : options_(options) {}
+
 	void setup();
 	void audioOut(float* output, int bufferSize, int nChannels);
 	void update();
 	void draw();
+	void exit();
 
 	void keyPressed(int key);
 	void keyReleased(int key);
@@ -26,4 +30,7 @@ public:
 	void gotMessage(ofMessage msg);
 
 	Iota iota_app;
+
+private:
+	RunOptions options_;
 };